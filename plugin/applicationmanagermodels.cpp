@@ -0,0 +1,187 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "applicationmanagermodels.h"
+
+#include <QDebug>
+#include <QJsonArray>
+
+#include "applicationmanagerservice.h"
+
+static const QLatin1String strRunning("running");
+static const QLatin1String strApps("apps");
+static const QLatin1String strApp("app");
+static const QLatin1String strPackages("packages");
+static const QLatin1String strId("id");
+static const QLatin1String strProcessid("processid");
+static const QLatin1String strProcessId("processId");
+static const QLatin1String strAppId("appId");
+static const QLatin1String strPackageId("packageId");
+static const QLatin1String strIcon("icon");
+static const QLatin1String strMiniIcon("miniIcon");
+static const QLatin1String strChange("change");
+static const QLatin1String strChangeAdded("added");
+static const QLatin1String strChangeRemoved("removed");
+static const QLatin1String strChangeUpdated("updated");
+static const QLatin1String strFileScheme("file://");
+
+// The members of a package that are passed through as they are
+static const char *const packageFields[] = {
+    "version", "size", "loc_name", "vendor", "vendorUrl", "userInstalled"
+};
+
+static QJsonObject appRow(const QJsonObject& app)
+{
+    // Provide the file scheme to the icon for reliable loading of the icon. Without
+    // it the path can be interpreted as a relative path to a resource file bundled
+    // with the binary
+    return QJsonObject{
+        {strIcon, strFileScheme + app.value(strIcon).toString()},
+        {strAppId, app.value(strId)}
+    };
+}
+
+ApplicationManagerListModel::ApplicationManagerListModel(const QString& key, QObject *parent)
+    : JsonListModel(key, parent)
+{
+}
+
+void ApplicationManagerListModel::setService(ApplicationManagerService *service)
+{
+    if (m_service == service)
+        return;
+
+    if (m_service)
+        disconnect(m_service, nullptr, this, nullptr);
+
+    m_service = service;
+    if (m_service)
+        attach(m_service);
+    Q_EMIT serviceChanged();
+}
+
+RunningProcessesModel::RunningProcessesModel(QObject *parent)
+    : ApplicationManagerListModel(strProcessId, parent)
+{
+}
+
+void RunningProcessesModel::attach(ApplicationManagerService *service)
+{
+    connect(service, &ApplicationManagerService::runningListPublished,
+            this, &RunningProcessesModel::runningListPublished);
+    service->subscribeRunningList();
+}
+
+void RunningProcessesModel::runningListPublished(const QJsonObject& reply)
+{
+    if (!reply.contains(strRunning))
+        return;
+
+    const QJsonArray running = reply.value(strRunning).toArray();
+    QVector<QJsonObject> rows;
+    rows.reserve(running.size());
+    for (const QJsonValue& value : running) {
+        const QJsonObject process = value.toObject();
+        rows.append(QJsonObject{
+            {strProcessId, process.value(strProcessid)},
+            {strAppId, process.value(strId)}
+        });
+    }
+    setRows(rows);
+}
+
+InstalledAppsModel::InstalledAppsModel(QObject *parent)
+    : ApplicationManagerListModel(strAppId, parent)
+{
+}
+
+void InstalledAppsModel::attach(ApplicationManagerService *service)
+{
+    connect(service, &ApplicationManagerService::applicationListPublished,
+            this, &InstalledAppsModel::applicationListPublished);
+}
+
+void InstalledAppsModel::applicationListPublished(const QJsonObject& reply)
+{
+    if (reply.contains(strApps)) {
+        const QJsonArray apps = reply.value(strApps).toArray();
+        QVector<QJsonObject> rows;
+        rows.reserve(apps.size());
+        for (const QJsonValue& value : apps)
+            rows.append(appRow(value.toObject()));
+        setRows(rows);
+        return;
+    }
+
+    // A change event of SAM on top of the last full list
+    const QString change = reply.value(strChange).toString();
+    const QJsonObject row = appRow(reply.value(strApp).toObject());
+    const int index = indexOf(idOf(row));
+
+    QVector<QJsonObject> list = rows();
+    if (change == strChangeAdded || change == strChangeUpdated) {
+        if (index >= 0)
+            list[index] = row;
+        else if (change == strChangeAdded)
+            list.append(row);
+    } else if (change == strChangeRemoved) {
+        if (index >= 0)
+            list.remove(index);
+    } else {
+        qWarning() << "InstalledAppsModel: Unhandled change:" << change;
+        return;
+    }
+    setRows(list);
+}
+
+InstalledPackagesModel::InstalledPackagesModel(QObject *parent)
+    : ApplicationManagerListModel(strPackageId, parent)
+{
+}
+
+void InstalledPackagesModel::attach(ApplicationManagerService *service)
+{
+    connect(service, &ApplicationManagerService::packagesListPublished,
+            this, &InstalledPackagesModel::packagesListPublished);
+    service->subscribePackagesList();
+}
+
+void InstalledPackagesModel::packagesListPublished(const QJsonObject& reply)
+{
+    if (!reply.contains(strPackages))
+        return;
+
+    const QJsonArray packages = reply.value(strPackages).toArray();
+    QVector<QJsonObject> rows;
+    rows.reserve(packages.size());
+    for (const QJsonValue& value : packages) {
+        const QJsonObject package = value.toObject();
+        QJsonObject row;
+        row.insert(strPackageId, package.value(strId));
+        // Every row has every role, null where the package lacks the field.
+        // Inserting an undefined value would drop the key instead.
+        for (const char *field : packageFields) {
+            const QString name = QLatin1String(field);
+            const QJsonValue value = package.value(name);
+            row.insert(name, value.isUndefined() ? QJsonValue() : value);
+        }
+        // Provide the file scheme to the icons, see appRow()
+        row.insert(strIcon, strFileScheme + package.value(strIcon).toString());
+        row.insert(strMiniIcon, strFileScheme + package.value(strMiniIcon).toString());
+        rows.append(row);
+    }
+    setRows(rows);
+}
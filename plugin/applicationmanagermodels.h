@@ -0,0 +1,124 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef APPLICATIONMANAGERMODELS_H
+#define APPLICATIONMANAGERMODELS_H
+
+#include <QPointer>
+
+#include "jsonlistmodel.h"
+
+class ApplicationManagerService;
+
+    /*!
+     * \class ApplicationManagerListModel
+     * \brief Base of the list models that follow a subscription of
+     * com.webos.applicationManager
+     *
+     * Every reply is mapped to rows and applied with
+     * JsonListModel::setRows(), so the views only see the rows that were
+     * inserted, removed, moved or changed.
+     */
+
+class ApplicationManagerListModel : public JsonListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(ApplicationManagerService *service READ service WRITE setService NOTIFY serviceChanged)
+
+Q_SIGNALS:
+    void serviceChanged();
+
+public:
+    ApplicationManagerService *service() const { return m_service; }
+    void setService(ApplicationManagerService *service);
+
+protected:
+    ApplicationManagerListModel(const QString& key, QObject *parent);
+
+    /*!
+     * \brief Connects the model to the replies of the service
+     */
+    virtual void attach(ApplicationManagerService *service) = 0;
+
+private:
+    QPointer<ApplicationManagerService> m_service;
+};
+
+    /*!
+     * \class RunningProcessesModel
+     * \brief Running applications, rows of {processId, appId} keyed on
+     * the process id
+     */
+
+class RunningProcessesModel : public ApplicationManagerListModel
+{
+    Q_OBJECT
+
+public:
+    explicit RunningProcessesModel(QObject *parent = nullptr);
+
+protected:
+    void attach(ApplicationManagerService *service) override;
+
+private slots:
+    void runningListPublished(const QJsonObject& reply);
+};
+
+    /*!
+     * \class InstalledAppsModel
+     * \brief Installed applications, rows of {appId, icon} keyed on the
+     * application id
+     *
+     * The list is not subscribed by the model, see
+     * ApplicationManagerService::subscribeApplicationList(). The change
+     * events that follow the full list are applied to the rows.
+     */
+
+class InstalledAppsModel : public ApplicationManagerListModel
+{
+    Q_OBJECT
+
+public:
+    explicit InstalledAppsModel(QObject *parent = nullptr);
+
+protected:
+    void attach(ApplicationManagerService *service) override;
+
+private slots:
+    void applicationListPublished(const QJsonObject& reply);
+};
+
+    /*!
+     * \class InstalledPackagesModel
+     * \brief Installed packages keyed on the package id
+     */
+
+class InstalledPackagesModel : public ApplicationManagerListModel
+{
+    Q_OBJECT
+
+public:
+    explicit InstalledPackagesModel(QObject *parent = nullptr);
+
+protected:
+    void attach(ApplicationManagerService *service) override;
+
+private slots:
+    void packagesListPublished(const QJsonObject& reply);
+};
+
+#endif // APPLICATIONMANAGERMODELS_H
@@ -18,10 +18,14 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QMetaMethod>
 #include <QProcess>
 
+#include "jsonlistdiff.h"
+
 static const QLatin1String strLeftBrace("{");
 static const QLatin1String strRightBrace("}");
 static const QLatin1String strSectionSeparator(" -");
@@ -42,14 +46,48 @@ static const QLatin1String methodMoveLaunchPoint("/moveLaunchPoint");
 static const QLatin1String methodListLaunchPoints("/listLaunchPoints");
 static const QLatin1String methodListApps("/listApps");
 static const QLatin1String methodRunning("/running");
+static const QLatin1String methodListPackages("/listPackages");
 static const QLatin1String methodGetAppLifeStatus("/getAppLifeStatus");
 static const QLatin1String methodGetAppLifeEvents("/getAppLifeEvents");
 static const QLatin1String serviceName("com.webos.applicationManager");
+static const QLatin1String strLaunchPoints("launchPoints");
+static const QLatin1String strLaunchPointId("launchPointId");
+static const QLatin1String strApps("apps");
+static const QLatin1String strApp("app");
+static const QLatin1String strId("id");
+static const QLatin1String strChange("change");
+static const QLatin1String strChangeAdded("added");
+static const QLatin1String strChangeRemoved("removed");
+static const QLatin1String strChangeUpdated("updated");
+
+// Applies a change event of SAM to the last full list
+static void applyChange(QJsonArray &list, const QString& change, const QJsonObject& entry, const QString& key)
+{
+    const QString id = entry.value(key).toString();
+    int i = 0;
+    while (i < list.size() && list.at(i).toObject().value(key).toString() != id)
+        ++i;
+
+    if (change == strChangeAdded) {
+        if (i < list.size())
+            list[i] = entry;
+        else
+            list.append(entry);
+    } else if (change == strChangeRemoved) {
+        if (i < list.size())
+            list.removeAt(i);
+    } else if (change == strChangeUpdated) {
+        if (i < list.size())
+            list[i] = entry;
+    }
+}
 
 ApplicationManagerService::ApplicationManagerService(QObject * parent)
     : MessageSpreaderListener(parent)
     , m_connected(false)
     , m_tokenServerStatus(LSMESSAGE_TOKEN_INVALID)
+    , m_tokenRunningList(LSMESSAGE_TOKEN_INVALID)
+    , m_tokenPackagesList(LSMESSAGE_TOKEN_INVALID)
 {
     connect(this, &Service::sessionIdChanged, this, &ApplicationManagerService::resetSubscription);
     m_spreadEvents = qgetenv("WEBOS_QML_WEBOSSERVICES_SPREAD_EVENTS").split(',').contains("ApplicationManagerService");
@@ -67,6 +105,11 @@ void ApplicationManagerService::cancel(LSMessageToken token)
 {
     Service::cancel(token);
 
+    if (token == LSMESSAGE_TOKEN_INVALID || token == m_tokenRunningList)
+        m_tokenRunningList = LSMESSAGE_TOKEN_INVALID;
+    if (token == LSMESSAGE_TOKEN_INVALID || token == m_tokenPackagesList)
+        m_tokenPackagesList = LSMESSAGE_TOKEN_INVALID;
+
     // the subscription to registerServerStatus is also cancelled this case, restore it
     if (token == LSMESSAGE_TOKEN_INVALID || token == m_tokenServerStatus)
         m_tokenServerStatus = registerServerStatus(interfaceName(), true);
@@ -89,8 +132,8 @@ int ApplicationManagerService::launch(const QString& identifier, const QString&
             + ",\"autoInstallation\":" + (autoInstallation ? "true" : "false")
             + ",\"reason\":\"" + reason + "\"}";
 
-        token = call(serviceUri(),
-              methodLaunch, methodParams);
+        token = callWithFlags(serviceUri(),
+              methodLaunch, methodParams, OneReplyCall);
         m_launchCalls[token] = identifier;
     }
     // Let's keep this in for demo purposes for now:
@@ -103,69 +146,100 @@ int ApplicationManagerService::launch(const QString& identifier, const QString&
 
 int ApplicationManagerService::removeLaunchPoint(const QString& identifier)
 {
-    return call(serviceUri(),
+    return callWithFlags(serviceUri(),
             methodRemoveLaunchPoint,
-            QString(QLatin1String("{\"launchPointId\":\"%1\"}")).arg(identifier));
+            QString(QLatin1String("{\"launchPointId\":\"%1\"}")).arg(identifier),
+            OneReplyCall);
 }
 
 int ApplicationManagerService::close(const QString& processId)
 {
     int token = 0;
-    token = call(serviceUri(),
+    token = callWithFlags(serviceUri(),
           methodClose,
-          QString(QLatin1String("{\"processId\":\"%1\"}")).arg(processId));
+          QString(QLatin1String("{\"processId\":\"%1\"}")).arg(processId),
+          OneReplyCall);
     m_closeCalls[token] = processId;
     return token;
 }
 
 int ApplicationManagerService::moveLaunchPoint(int index, int to)
 {
-    return call(serviceUri(),
+    return callWithFlags(serviceUri(),
           methodMoveLaunchPoint,
-          QString(QLatin1String("{ \"index\": %1, \"to\": %2 }")).arg(index).arg(to));
+          QString(QLatin1String("{ \"index\": %1, \"to\": %2 }")).arg(index).arg(to),
+          OneReplyCall);
 }
 
 QString ApplicationManagerService::runningList()
 {
-    call(serviceUri(),
+    if (m_tokenRunningList == LSMESSAGE_TOKEN_INVALID)
+        m_tokenRunningList = subscribeRunningList();
+
+    return m_runningList.toString();
+}
+
+QString ApplicationManagerService::packagesList()
+{
+    if (m_tokenPackagesList == LSMESSAGE_TOKEN_INVALID)
+        m_tokenPackagesList = subscribePackagesList();
+
+    return m_packagesList.toString();
+}
+
+int ApplicationManagerService::subscribeRunningList()
+{
+    return callWithFlags(serviceUri(),
           methodRunning,
-          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+          SubscriptionCall);
+}
 
-    return m_runningList;
+int ApplicationManagerService::subscribePackagesList()
+{
+    return callWithFlags(serviceUri(),
+          methodListPackages,
+          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+          SubscriptionCall);
 }
 
 int ApplicationManagerService::subscribeAppLifeStatus()
 {
     return callWithRetry(serviceUri(),
             methodGetAppLifeStatus,
-            QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+            QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+            5, SubscriptionCall);
 }
 
 int ApplicationManagerService::subscribeAppLifeEvents()
 {
     return callWithRetry(serviceUri(),
             methodGetAppLifeEvents,
-            QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+            QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+            5, SubscriptionCall);
 }
 
 int ApplicationManagerService::subscribeApplicationList()
 {
     return callWithRetry(serviceUri(),
           methodListApps,
-          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+          5, SubscriptionCall);
 }
 
 int ApplicationManagerService::subscribeLaunchPointsList()
 {
     return callWithRetry(serviceUri(),
           methodListLaunchPoints,
-          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+          QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+          5, SubscriptionCall);
 }
 
-void ApplicationManagerService::serviceResponseDelayed(const QString& method, const QString& payload, int token, const QJsonObject &rootObject)
+void ApplicationManagerService::serviceResponseDelayed(const QString& method, const LunaServiceReply& reply, int token)
 {
+    const QJsonObject &rootObject = reply.object();
     checkForErrors(rootObject, token);
-    Q_EMIT response(method, payload, token);
+    emitResponse(method, reply, token);
 
     if (token < 0) {
         qWarning() << "token is not valid";
@@ -181,26 +255,39 @@ void ApplicationManagerService::serviceResponseDelayed(const QString& method, co
         }
     }
     else if (method == methodListApps) {
-        if (payload == m_applicationList) return;
-        m_applicationList = payload;
-        m_jsonApplicationList = QVariant(rootObject);
+        if (!m_applicationList.update(reply)) return;
+        JsonListDelta delta;
+        const bool notifyDelta = updateApplications(rootObject, &delta);
         Q_EMIT(applicationListChanged());
         Q_EMIT(jsonApplicationListChanged());
+        // After the lists, so that a handler reads the list the delta leads to
+        if (notifyDelta)
+            Q_EMIT applicationListDelta(delta.added, delta.removed, delta.updated, delta.moved);
+        Q_EMIT(applicationListPublished(rootObject));
     }
     else if (method == methodListLaunchPoints) {
-        if ( payload == m_launchPointsList ) {
+        if (!m_launchPointsList.update(reply)) {
+            Q_EMIT(launchPointsPublished(rootObject, false));
             Q_EMIT(sameLaunchPointsListPublished());
             return;
         }
-        m_launchPointsList = payload;
-        m_jsonLaunchPointsList = QVariant(rootObject);
+        JsonListDelta delta;
+        const bool notifyDelta = updateLaunchPoints(rootObject, &delta);
         Q_EMIT(launchPointsListChanged());
         Q_EMIT(jsonLaunchPointsListChanged());
+        if (notifyDelta)
+            Q_EMIT launchPointsDelta(delta.added, delta.removed, delta.updated, delta.moved);
+        Q_EMIT(launchPointsPublished(rootObject, true));
     }
     else if (method == methodRunning) {
-        if (payload == m_runningList) return;
-        m_runningList = payload;
+        if (!m_runningList.update(reply)) return;
         Q_EMIT(runningListChanged());
+        Q_EMIT(runningListPublished(rootObject));
+    }
+    else if (method == methodListPackages) {
+        if (!m_packagesList.update(reply)) return;
+        Q_EMIT(packagesListChanged());
+        Q_EMIT(packagesListPublished(rootObject));
     }
     else if (method == methodLaunch) {
         bool returnValue = rootObject.value(strReturnValue).toBool();
@@ -247,9 +334,50 @@ void ApplicationManagerService::serviceResponseDelayed(const QString& method, co
     else qWarning() << "ApplicationManagerService: Unknown method:"<<method;
 }
 
-void ApplicationManagerService::hubError(const QString& method, const QString& error, const QString& payload, int token)
+bool ApplicationManagerService::updateLaunchPoints(const QJsonObject& rootObject, JsonListDelta *delta)
+{
+    if (!rootObject.contains(strLaunchPoints)) {
+        // Change events carry the launch point itself in the root object
+        if (m_hasLaunchPoints)
+            applyChange(m_launchPoints, rootObject.value(strChange).toString(), rootObject, strLaunchPointId);
+        return false;
+    }
+
+    const QJsonArray launchPoints = rootObject.value(strLaunchPoints).toArray();
+
+    static const QMetaMethod deltaSignal = QMetaMethod::fromSignal(&ApplicationManagerService::launchPointsDelta);
+    const bool notifyDelta = m_hasLaunchPoints && isSignalConnected(deltaSignal);
+    if (notifyDelta)
+        *delta = JsonListDelta::compute(m_launchPoints, launchPoints, strLaunchPointId);
+
+    m_launchPoints = launchPoints;
+    m_hasLaunchPoints = true;
+    return notifyDelta;
+}
+
+bool ApplicationManagerService::updateApplications(const QJsonObject& rootObject, JsonListDelta *delta)
+{
+    if (!rootObject.contains(strApps)) {
+        if (m_hasApplications)
+            applyChange(m_applications, rootObject.value(strChange).toString(), rootObject.value(strApp).toObject(), strId);
+        return false;
+    }
+
+    const QJsonArray applications = rootObject.value(strApps).toArray();
+
+    static const QMetaMethod deltaSignal = QMetaMethod::fromSignal(&ApplicationManagerService::applicationListDelta);
+    const bool notifyDelta = m_hasApplications && isSignalConnected(deltaSignal);
+    if (notifyDelta)
+        *delta = JsonListDelta::compute(m_applications, applications, strId);
+
+    m_applications = applications;
+    m_hasApplications = true;
+    return notifyDelta;
+}
+
+void ApplicationManagerService::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
 {
-    checkForErrors(payload, token);
+    checkForErrors(reply, token);
 
     if (error == LUNABUS_ERROR_SERVICE_DOWN) {
         qWarning() << "ApplicationManagerService: Hub error:" << error << "- recover subscriptions";
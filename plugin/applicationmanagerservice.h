@@ -18,10 +18,14 @@
 #define APPLICATIONMANAGERSERVICE_H
 
 #include "service.h"
+#include "retainedstate.h"
 #include <QUrl>
 #include <QHash>
+#include <QJsonArray>
 #include <QVariant>
 
+class JsonListDelta;
+
     /*!
      * \class ApplicationManagerService
      * \brief Provides QML property bindings for the service
@@ -42,6 +46,7 @@ class ApplicationManagerService : public MessageSpreaderListener
     Q_PROPERTY(QString applicationList READ applicationList NOTIFY applicationListChanged)
     Q_PROPERTY(QString launchPointsList READ launchPointsList NOTIFY launchPointsListChanged)
     Q_PROPERTY(QString runningList READ runningList NOTIFY runningListChanged)
+    Q_PROPERTY(QString packagesList READ packagesList NOTIFY packagesListChanged)
     Q_PROPERTY(bool connected READ connected NOTIFY connectedChanged)
     Q_PROPERTY(QVariant jsonApplicationList READ jsonApplicationList NOTIFY jsonApplicationListChanged)
     Q_PROPERTY(QVariant jsonLaunchPointsList READ jsonLaunchPointsList NOTIFY jsonLaunchPointsListChanged)
@@ -64,9 +69,41 @@ Q_SIGNALS:
     void launchPointsListChanged();
     void jsonLaunchPointsListChanged();
     void runningListChanged();
+    void packagesListChanged();
     void connectedChanged();
     void sameLaunchPointsListPublished();
 
+    /*!
+     * \brief Emitted for every reply of listLaunchPoints with the reply
+     * itself, changed is false when it repeats the last one
+     * \see LaunchPointsListModel
+     */
+    void launchPointsPublished(const QJsonObject& reply, bool changed);
+
+    /*!
+     * \brief Emitted for every reply of listApps, running and listPackages
+     * that differs from the last one, with the reply itself
+     */
+    void applicationListPublished(const QJsonObject& reply);
+    void runningListPublished(const QJsonObject& reply);
+    void packagesListPublished(const QJsonObject& reply);
+
+    /*!
+     * \brief Emitted when a full list of launch points follows another one,
+     * after launchPointsListChanged(), with only the launch points that
+     * changed. The launch points are keyed on their launchPointId and the
+     * items are as described in JsonListDelta.
+     */
+    void launchPointsDelta(const QVariantList& added, const QVariantList& removed,
+                           const QVariantList& updated, const QVariantList& moved);
+
+    /*!
+     * \brief Same as launchPointsDelta() for the full lists of applications,
+     * keyed on their id
+     */
+    void applicationListDelta(const QVariantList& added, const QVariantList& removed,
+                              const QVariantList& updated, const QVariantList& moved);
+
 public:
     ApplicationManagerService(QObject * parent = 0);
 
@@ -85,14 +122,17 @@ public:
     Q_INVOKABLE int subscribeAppLifeEvents();
     Q_INVOKABLE int subscribeApplicationList();
     Q_INVOKABLE int subscribeLaunchPointsList();
+    Q_INVOKABLE int subscribeRunningList();
+    Q_INVOKABLE int subscribePackagesList();
 
     void setAppId(const QString& appId);
 
-    QString applicationList() { return m_applicationList; };
-    QVariant jsonApplicationList() { return m_jsonApplicationList; };
-    QString launchPointsList() { return m_launchPointsList; };
-    QVariant jsonLaunchPointsList() { return m_jsonLaunchPointsList; };
+    QString applicationList() { return m_applicationList.toString(); };
+    QVariant jsonApplicationList() { return m_applicationList.toVariant(); };
+    QString launchPointsList() { return m_launchPointsList.toString(); };
+    QVariant jsonLaunchPointsList() { return m_launchPointsList.toVariant(); };
     QString runningList();
+    QString packagesList();
     bool connected() { return m_connected; }
 
     QString interfaceName() const;
@@ -103,25 +143,38 @@ protected:
      * the response signal.
      * \param method The method of the service that has been called
        (e.g. "/getPreferences")
-     * \param payload The raw JSON reply from the bus
+     * \param reply The reply from the bus
      * \param token Provides the caller's token that is answered
      * by this reply
      */
-    void serviceResponseDelayed(const QString& method, const QString& payload, int token, const QJsonObject &jsonPayload) override;
+    void serviceResponseDelayed(const QString& method, const LunaServiceReply& reply, int token) override;
 
-    void hubError(const QString& method, const QString& error, const QString& payload, int token);
+    void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token);
 
 protected slots:
     void resetSubscription();
 
+private:
+    // Return whether delta is to be emitted
+    bool updateLaunchPoints(const QJsonObject& rootObject, JsonListDelta *delta);
+    bool updateApplications(const QJsonObject& rootObject, JsonListDelta *delta);
+
 private:
     bool m_connected;
     LSMessageToken m_tokenServerStatus;
-    QString m_applicationList;
-    QVariant m_jsonApplicationList;
-    QString m_launchPointsList;
-    QVariant m_jsonLaunchPointsList;
-    QString m_runningList;
+    // Subscriptions opened by the getters, once
+    LSMessageToken m_tokenRunningList;
+    LSMessageToken m_tokenPackagesList;
+    RetainedState m_applicationList;
+    RetainedState m_launchPointsList;
+    RetainedState m_runningList;
+    RetainedState m_packagesList;
+    // Last full lists kept in sync with the change events, the base of the
+    // deltas. Shared with the retained reply until a change event is applied.
+    QJsonArray m_launchPoints;
+    QJsonArray m_applications;
+    bool m_hasLaunchPoints = false;
+    bool m_hasApplications = false;
     QHash<int, QString> m_launchCalls;
     QHash<int, QString> m_closeCalls;
 };
@@ -0,0 +1,334 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "busmetrics.h"
+
+#include <atomic>
+#include <chrono>
+
+#include <QHash>
+#include <QMap>
+#include <QMutex>
+#include <QVector>
+#include <luna-service2/lunaservice.h>
+
+namespace {
+
+// Only the owning thread writes, the GUI thread reads
+struct Counters
+{
+    std::atomic<quint64> calls{0};
+    std::atomic<quint64> replies{0};
+    std::atomic<quint64> payloadSize{0};
+    std::atomic<quint64> parses{0};
+    std::atomic<quint64> parseTime{0};
+    std::atomic<quint64> handlers{0};
+    std::atomic<quint64> handlerTime{0};
+    std::atomic<quint64> offloads{0};
+    std::atomic<quint64> coalesced{0};
+    std::atomic<quint64> offloadSwitches{0};
+    std::atomic<quint64> latency[BusMetrics::latencyBuckets];
+
+    Counters()
+    {
+        for (std::atomic<quint64> &bucket : latency)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct Entry
+{
+    const char *uri;
+    Counters *counters;
+};
+
+struct Registry
+{
+    QMutex mutex;
+    QVector<Entry> entries;
+};
+
+Q_GLOBAL_STATIC(Registry, s_registry)
+
+inline void add(std::atomic<quint64> &counter, quint64 value)
+{
+    // Single writer, no read-modify-write needed
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline quint64 read(const std::atomic<quint64> &counter)
+{
+    return counter.load(std::memory_order_relaxed);
+}
+
+Counters *threadCounters(const char *uri)
+{
+    thread_local QHash<const char *, Counters *> t_counters;
+
+    Counters *&counters = t_counters[uri];
+    if (!counters) {
+        // Kept for the lifetime of the process, the totals outlive the thread
+        counters = new Counters();
+        Registry *registry = s_registry();
+        QMutexLocker locker(&registry->mutex);
+        registry->entries.append(Entry{uri, counters});
+    }
+    return counters;
+}
+
+int latencyBucket(qint64 latency)
+{
+    quint64 us = quint64(latency) / 1000;
+    int bucket = 0;
+    while (us && bucket < BusMetrics::latencyBuckets - 1) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Upper bound of the bucket holding the given fraction of the samples
+double latencyPercentile(const QVector<quint64> &histogram, quint64 count, double fraction)
+{
+    if (count == 0)
+        return 0;
+
+    const quint64 rank = quint64(fraction * count + 0.5);
+    quint64 seen = 0;
+    for (int i = 0; i < histogram.size(); ++i) {
+        seen += histogram.at(i);
+        if (seen >= rank && seen > 0)
+            return double(quint64(1) << i) / 1000.0;
+    }
+    return double(quint64(1) << (histogram.size() - 1)) / 1000.0;
+}
+
+} // namespace
+
+bool BusMetrics::isEnabled()
+{
+    static const bool s_enabled = qgetenv("WEBOS_QML_WEBOSSERVICES_BUS_METRICS") == "1";
+    return s_enabled;
+}
+
+BusMetrics *BusMetrics::instance()
+{
+    static BusMetrics *s_instance = new BusMetrics();
+    return s_instance;
+}
+
+BusMetrics::BusMetrics()
+{
+    m_since.start();
+
+    int dumpInterval = qgetenv("WEBOS_QML_WEBOSSERVICES_BUS_METRICS_DUMP_MS").toInt();
+    if (isEnabled() && dumpInterval > 0) {
+        connect(&m_dumpTimer, &QTimer::timeout, this, &BusMetrics::dump);
+        m_dumpTimer.start(dumpInterval);
+    }
+}
+
+qint64 BusMetrics::now()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void BusMetrics::recordCall(const char *uri)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    add(threadCounters(uri)->calls, 1);
+}
+
+void BusMetrics::recordReply(const char *uri, int payloadSize, qint64 latency)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    Counters *counters = threadCounters(uri);
+    add(counters->replies, 1);
+    add(counters->payloadSize, payloadSize);
+    if (latency >= 0)
+        add(counters->latency[latencyBucket(latency)], 1);
+}
+
+void BusMetrics::recordParse(const char *uri, qint64 duration)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    Counters *counters = threadCounters(uri);
+    add(counters->parses, 1);
+    add(counters->parseTime, duration);
+}
+
+void BusMetrics::recordHandler(const char *uri, qint64 duration)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    Counters *counters = threadCounters(uri);
+    add(counters->handlers, 1);
+    add(counters->handlerTime, duration);
+}
+
+void BusMetrics::recordOffload(const char *uri)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    add(threadCounters(uri)->offloads, 1);
+}
+
+void BusMetrics::recordCoalesced(const char *uri)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    add(threadCounters(uri)->coalesced, 1);
+}
+
+void BusMetrics::recordOffloadSwitch(const char *uri)
+{
+    if (!isEnabled() || !uri)
+        return;
+
+    add(threadCounters(uri)->offloadSwitches, 1);
+}
+
+QVariantList BusMetrics::snapshot() const
+{
+    struct Totals
+    {
+        quint64 calls = 0;
+        quint64 replies = 0;
+        quint64 payloadSize = 0;
+        quint64 parses = 0;
+        quint64 parseTime = 0;
+        quint64 handlers = 0;
+        quint64 handlerTime = 0;
+        quint64 offloads = 0;
+        quint64 coalesced = 0;
+        quint64 offloadSwitches = 0;
+        QVector<quint64> latency = QVector<quint64>(BusMetrics::latencyBuckets, 0);
+    };
+
+    // The URIs are interned, so threads share the same key for a method
+    QMap<const char *, Totals> totals;
+    {
+        Registry *registry = s_registry();
+        QMutexLocker locker(&registry->mutex);
+        for (const Entry &entry : registry->entries) {
+            Totals &total = totals[entry.uri];
+            const Counters *counters = entry.counters;
+            total.calls += read(counters->calls);
+            total.replies += read(counters->replies);
+            total.payloadSize += read(counters->payloadSize);
+            total.parses += read(counters->parses);
+            total.parseTime += read(counters->parseTime);
+            total.handlers += read(counters->handlers);
+            total.handlerTime += read(counters->handlerTime);
+            total.offloads += read(counters->offloads);
+            total.coalesced += read(counters->coalesced);
+            total.offloadSwitches += read(counters->offloadSwitches);
+            for (int i = 0; i < latencyBuckets; ++i)
+                total.latency[i] += read(counters->latency[i]);
+        }
+    }
+
+    const double seconds = qMax<qint64>(m_since.elapsed(), 1) / 1000.0;
+
+    QVariantList list;
+    for (auto it = totals.constBegin(); it != totals.constEnd(); ++it) {
+        const Totals &total = it.value();
+
+        quint64 latencyCount = 0;
+        QVariantList histogram;
+        for (quint64 bucket : total.latency) {
+            latencyCount += bucket;
+            histogram.append(bucket);
+        }
+
+        QVariantMap item;
+        item.insert(QStringLiteral("uri"), QString::fromUtf8(it.key()));
+        item.insert(QStringLiteral("calls"), total.calls);
+        item.insert(QStringLiteral("replies"), total.replies);
+        item.insert(QStringLiteral("repliesPerSecond"), total.replies / seconds);
+        item.insert(QStringLiteral("payloadSize"), total.payloadSize);
+        item.insert(QStringLiteral("parses"), total.parses);
+        item.insert(QStringLiteral("parseMs"), total.parseTime / 1e6);
+        item.insert(QStringLiteral("handlers"), total.handlers);
+        item.insert(QStringLiteral("handlerMs"), total.handlerTime / 1e6);
+        item.insert(QStringLiteral("offloads"), total.offloads);
+        item.insert(QStringLiteral("coalesced"), total.coalesced);
+        item.insert(QStringLiteral("offloadSwitches"), total.offloadSwitches);
+        item.insert(QStringLiteral("latencyP50Ms"), latencyPercentile(total.latency, latencyCount, 0.50));
+        item.insert(QStringLiteral("latencyP99Ms"), latencyPercentile(total.latency, latencyCount, 0.99));
+        item.insert(QStringLiteral("latencyHistogram"), histogram);
+        list.append(item);
+    }
+
+    return list;
+}
+
+void BusMetrics::reset()
+{
+    Registry *registry = s_registry();
+    QMutexLocker locker(&registry->mutex);
+    for (const Entry &entry : registry->entries) {
+        Counters *counters = entry.counters;
+        counters->calls.store(0, std::memory_order_relaxed);
+        counters->replies.store(0, std::memory_order_relaxed);
+        counters->payloadSize.store(0, std::memory_order_relaxed);
+        counters->parses.store(0, std::memory_order_relaxed);
+        counters->parseTime.store(0, std::memory_order_relaxed);
+        counters->handlers.store(0, std::memory_order_relaxed);
+        counters->handlerTime.store(0, std::memory_order_relaxed);
+        counters->offloads.store(0, std::memory_order_relaxed);
+        counters->coalesced.store(0, std::memory_order_relaxed);
+        counters->offloadSwitches.store(0, std::memory_order_relaxed);
+        for (std::atomic<quint64> &bucket : counters->latency)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+    m_since.restart();
+}
+
+void BusMetrics::dump() const
+{
+    static PmLogContext s_context = nullptr;
+    if (!s_context)
+        PmLogGetContext("qml-webos-bridge", &s_context);
+
+    for (const QVariant &value : snapshot()) {
+        const QVariantMap item = value.toMap();
+        PmLogInfo(s_context, "BUS_METRICS", 0,
+                  "%s calls=%llu replies=%llu rate=%.1f/s bytes=%llu parse=%.2fms handler=%.2fms offloads=%llu switches=%llu coalesced=%llu p50=%.2fms p99=%.2fms",
+                  qPrintable(item.value(QStringLiteral("uri")).toString()),
+                  item.value(QStringLiteral("calls")).toULongLong(),
+                  item.value(QStringLiteral("replies")).toULongLong(),
+                  item.value(QStringLiteral("repliesPerSecond")).toDouble(),
+                  item.value(QStringLiteral("payloadSize")).toULongLong(),
+                  item.value(QStringLiteral("parseMs")).toDouble(),
+                  item.value(QStringLiteral("handlerMs")).toDouble(),
+                  item.value(QStringLiteral("offloads")).toULongLong(),
+                  item.value(QStringLiteral("offloadSwitches")).toULongLong(),
+                  item.value(QStringLiteral("coalesced")).toULongLong(),
+                  item.value(QStringLiteral("latencyP50Ms")).toDouble(),
+                  item.value(QStringLiteral("latencyP99Ms")).toDouble());
+    }
+}
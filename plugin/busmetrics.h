@@ -0,0 +1,109 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BUSMETRICS_H
+#define BUSMETRICS_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVariant>
+
+    /*!
+     * \class BusMetrics
+     * \brief Per method latency and throughput counters of the bus layer
+     *
+     * The metrics are collected when WEBOS_QML_WEBOSSERVICES_BUS_METRICS=1
+     * is set, otherwise every record function returns right away. They are
+     * keyed on the interned "service/method" URI of the call and cover:
+     * - the number of calls and replies and the reply rate,
+     * - the payload size of the replies,
+     * - the latency from a call to its first reply (log2 histogram in us),
+     * - the time spent parsing the replies, on whatever thread parses,
+     * - the time spent in the reply handlers on the GUI thread,
+     * - the replies offloaded or coalesced and how often the
+     *   OffloadPolicy changed its mind.
+     *
+     * Each thread writes its own counters, so recording takes no lock.
+     * With WEBOS_QML_WEBOSSERVICES_BUS_METRICS_DUMP_MS set the metrics are
+     * also written to PmLog with that period.
+     *
+     * The object is exposed to QML as the BusMetrics singleton.
+     */
+
+class BusMetrics : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool enabled READ isEnabled CONSTANT)
+
+public:
+    static const int latencyBuckets = 24;
+
+    static bool isEnabled();
+
+    /*!
+     * \brief Obtains the singleton, must be called on the GUI thread first
+     */
+    static BusMetrics *instance();
+
+    /*!
+     * \brief Monotonic time in nanoseconds
+     */
+    static qint64 now();
+
+    static void recordCall(const char *uri);
+    /*!
+     * \param latency Nanoseconds since the call for its first reply, -1 otherwise
+     */
+    static void recordReply(const char *uri, int payloadSize, qint64 latency);
+    static void recordParse(const char *uri, qint64 duration);
+    static void recordHandler(const char *uri, qint64 duration);
+    /*!
+     * \brief A reply handed to the DecodePool to be parsed
+     */
+    static void recordOffload(const char *uri);
+    /*!
+     * \brief A subscription reply held back to be coalesced
+     */
+    static void recordCoalesced(const char *uri);
+    /*!
+     * \brief The OffloadPolicy turned offloading on or off for the method
+     */
+    static void recordOffloadSwitch(const char *uri);
+
+    /*!
+     * \brief One object per method with its counters, latencies in ms
+     */
+    Q_INVOKABLE QVariantList snapshot() const;
+
+    /*!
+     * \brief Clears the counters. Values recorded at the same time may be lost.
+     */
+    Q_INVOKABLE void reset();
+
+    /*!
+     * \brief Writes the current metrics to PmLog
+     */
+    Q_INVOKABLE void dump() const;
+
+private:
+    BusMetrics();
+
+    QElapsedTimer m_since;
+    QTimer m_dumpTimer;
+};
+
+#endif // BUSMETRICS_H
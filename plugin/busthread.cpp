@@ -0,0 +1,117 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "busthread.h"
+
+#include <QDebug>
+
+#include "lunaservicemgr.h"
+
+static const size_t s_ringCapacity = 1024;
+
+BusThread *BusThread::instance()
+{
+    static BusThread *s_instance = nullptr;
+    static bool s_checked = false;
+
+    if (!s_checked) {
+        s_checked = true;
+        if (qgetenv("WEBOS_QML_WEBOSSERVICES_BUS_THREAD") == "1") {
+            s_instance = new BusThread();
+            s_instance->start();
+            qInfo() << "LS2 I/O runs on a dedicated bus thread";
+        }
+    }
+
+    return s_instance;
+}
+
+BusThread::BusThread()
+    : m_context(g_main_context_new())
+    , m_loop(g_main_loop_new(m_context, FALSE))
+    , m_replies(s_ringCapacity)
+    , m_drainScheduled(false)
+    , m_stopping(false)
+{
+    setObjectName(QStringLiteral("LS2 bus"));
+}
+
+BusThread::~BusThread()
+{
+    {
+        // Nothing drains anymore, let a blocked post() drop its reply
+        QMutexLocker locker(&m_roomMutex);
+        m_stopping = true;
+        m_roomAvailable.wakeAll();
+    }
+
+    g_main_loop_quit(m_loop);
+    wait();
+
+    g_main_loop_unref(m_loop);
+    g_main_context_unref(m_context);
+}
+
+void BusThread::run()
+{
+    g_main_context_push_thread_default(m_context);
+    g_main_loop_run(m_loop);
+    g_main_context_pop_thread_default(m_context);
+}
+
+void BusThread::post(BusReply &reply)
+{
+    if (!m_replies.push(reply)) {
+        // The GUI thread is behind, make sure it drains and wait for room
+        scheduleDrain();
+
+        QMutexLocker locker(&m_roomMutex);
+        while (!m_replies.push(reply)) {
+            if (m_stopping)
+                return;
+            m_roomAvailable.wait(&m_roomMutex);
+        }
+    }
+
+    scheduleDrain();
+}
+
+void BusThread::scheduleDrain()
+{
+    // One event per batch: nothing is posted while a drain is pending
+    if (!m_drainScheduled.exchange(true))
+        QMetaObject::invokeMethod(this, "drain", Qt::QueuedConnection);
+}
+
+void BusThread::drain()
+{
+    // Cleared first so that a reply pushed after the last pop schedules a new drain
+    m_drainScheduled.store(false);
+
+    // Only what is there now, the replies that keep coming wait for the next drain
+    size_t count = m_replies.size();
+    BusReply reply;
+    while (count-- && m_replies.pop(reply))
+        LunaServiceManager::dispatchReply(reply);
+
+    {
+        QMutexLocker locker(&m_roomMutex);
+        m_roomAvailable.wakeAll();
+    }
+
+    if (!m_replies.isEmpty())
+        scheduleDrain();
+}
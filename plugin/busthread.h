@@ -0,0 +1,109 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef BUSTHREAD_H
+#define BUSTHREAD_H
+
+#include <atomic>
+
+#include <QMutex>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <glib.h>
+#include <luna-service2/lunaservice.h>
+
+#include "lunaservicereply.h"
+#include "spscring.h"
+
+/*!
+ * \brief A reply read on the bus thread, waiting to be dispatched
+ */
+struct BusReply
+{
+    BusReply() : handle(nullptr), token(LSMESSAGE_TOKEN_INVALID), generation(0), hubError(false) {}
+
+    LSHandle *handle;
+    LSMessageToken token;
+    quint32 generation;
+    bool hubError;
+    QString hubErrorMethod;
+    LunaServiceReply reply;
+};
+
+    /*!
+     * \class BusThread
+     * \brief Runs the LS2 I/O on a dedicated thread
+     *
+     * This mode is enabled by setting WEBOS_QML_WEBOSSERVICES_BUS_THREAD=1.
+     * The bus handles are then attached to a GMainContext iterated by this
+     * thread instead of the default context of the GUI thread. Socket
+     * reads, message framing, the payload copy and the JSON parse happen
+     * here; the ready replies are handed to the GUI thread through a
+     * lock-free single-producer single-consumer ring that is drained once
+     * per event loop iteration, where they are dispatched to the listeners
+     * exactly like in the default mode.
+     *
+     * A drain dispatches at most the replies that are there when it starts
+     * and queues another drain for the rest, so that other events get in.
+     * When the ring is full the bus thread waits for a drain to make room.
+     *
+     * \see LunaServiceManager
+     */
+
+class BusThread : public QThread
+{
+    Q_OBJECT
+public:
+    /*!
+     * \brief Obtains the bus thread, started on first use
+     *
+     * \return The bus thread or nullptr if the mode is not enabled
+     */
+    static BusThread *instance();
+
+    ~BusThread();
+
+    GMainContext *context() const { return m_context; }
+
+    /*!
+     * \brief Queues a reply for the GUI thread. Called on the bus thread only,
+     * blocks while the ring is full.
+     */
+    void post(BusReply &reply);
+
+protected:
+    void run() override;
+
+private slots:
+    void drain();
+
+private:
+    BusThread();
+
+    void scheduleDrain();
+
+    GMainContext *m_context;
+    GMainLoop *m_loop;
+    SpscRing<BusReply> m_replies;
+    std::atomic<bool> m_drainScheduled;
+    // The bus thread waits here while the ring is full
+    QMutex m_roomMutex;
+    QWaitCondition m_roomAvailable;
+    bool m_stopping;
+};
+
+#endif // BUSTHREAD_H
@@ -0,0 +1,79 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "callbatch.h"
+
+#include <QDebug>
+
+CallBatch::CallBatch(int id, LunaServiceManagerListener *owner, int size)
+    : LunaServiceManagerListener(owner)
+    , m_id(id)
+    , m_owner(owner)
+    , m_results(size)
+    , m_pending(0)
+    , m_issuing(true)
+{
+}
+
+void CallBatch::serviceResponse(const QString& method, const LunaServiceReply& reply, int token)
+{
+    Q_UNUSED(method);
+    setResult(token, reply, QString());
+}
+
+void CallBatch::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
+{
+    Q_UNUSED(method);
+    setResult(token, reply, error);
+}
+
+void CallBatch::setIssued(int index, const QString& method, LSMessageToken token)
+{
+    m_results[index].method = method;
+    m_results[index].token = token;
+    if (token != LSMESSAGE_TOKEN_INVALID)
+        m_pending++;
+}
+
+void CallBatch::finishIssuing()
+{
+    m_issuing = false;
+
+    // Nothing could be issued: still complete from the event loop so
+    // that the caller knows the batch id before the result comes in
+    if (m_pending == 0)
+        QMetaObject::invokeMethod(this, [this]() { complete(); }, Qt::QueuedConnection);
+}
+
+void CallBatch::setResult(int token, const LunaServiceReply& reply, const QString& hubError)
+{
+    for (BatchResult &result : m_results) {
+        if (result.token == (LSMessageToken) token) {
+            result.reply = reply;
+            result.hubError = hubError;
+            break;
+        }
+    }
+
+    if (--m_pending == 0 && !m_issuing)
+        complete();
+}
+
+void CallBatch::complete()
+{
+    m_owner->batchResponse(m_id, m_results);
+    deleteLater();
+}
@@ -0,0 +1,65 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CALLBATCH_H
+#define CALLBATCH_H
+
+#include <QVector>
+
+#include "lunaservicemgr.h"
+
+    /*!
+     * \class CallBatch
+     * \brief Collects the replies of a batch of calls
+     *
+     * The batch is the listener of all of its calls and a child of the
+     * listener that issued it, so it goes away with its owner. Once every
+     * call has been answered the owner gets one batchResponse() and the
+     * batch deletes itself.
+     *
+     * \see LunaServiceManager::callBatch()
+     */
+
+class CallBatch : public LunaServiceManagerListener
+{
+public:
+    CallBatch(int id, LunaServiceManagerListener *owner, int size);
+
+    void serviceResponse(const QString& method, const LunaServiceReply& reply, int token) override;
+    void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token) override;
+
+    /*!
+     * \brief Records how a call has been issued
+     */
+    void setIssued(int index, const QString& method, LSMessageToken token);
+
+    /*!
+     * \brief Called once all the calls are issued
+     */
+    void finishIssuing();
+
+private:
+    void setResult(int token, const LunaServiceReply& reply, const QString& hubError);
+    void complete();
+
+    int m_id;
+    LunaServiceManagerListener *m_owner;
+    QVector<BatchResult> m_results;
+    int m_pending;
+    bool m_issuing;
+};
+
+#endif // CALLBATCH_H
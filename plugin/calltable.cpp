@@ -0,0 +1,187 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "calltable.h"
+
+#include "lunaservicemgr.h"
+
+static const int s_initialCapacity = 64;
+
+static inline int slotHash(LSMessageToken token)
+{
+    // Fibonacci hashing spreads the sequential tokens over the table
+    return int((quint64(token) * Q_UINT64_C(0x9E3779B97F4A7C15)) >> 33);
+}
+
+CallTable *CallTable::instance()
+{
+    static CallTable s_instance;
+    return &s_instance;
+}
+
+CallTable::CallTable()
+    : m_size(0)
+    , m_mask(0)
+    , m_generation(0)
+{
+    rehash(s_initialCapacity);
+}
+
+quint32 CallTable::nextGeneration()
+{
+    if (++m_generation == 0)
+        ++m_generation;
+    return m_generation;
+}
+
+int CallTable::indexOf(LSHandle *handle, LSMessageToken token) const
+{
+    for (int i = slotHash(token) & m_mask; ; i = (i + 1) & m_mask) {
+        const Slot &slot = m_slots.at(i);
+        if (slot.token == LSMESSAGE_TOKEN_INVALID)
+            return -1;
+        if (slot.token == token && slot.handle == handle)
+            return i;
+    }
+}
+
+void CallTable::insert(const Slot& slot)
+{
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    if ((m_size + 1) * 2 > m_slots.size())
+        rehash(m_slots.size() * 2);
+
+    int i = slotHash(slot.token) & m_mask;
+    while (m_slots.at(i).token != LSMESSAGE_TOKEN_INVALID) {
+        Slot &existing = m_slots[i];
+        if (existing.token == slot.token && existing.handle == slot.handle) {
+            existing.listener->m_pendingCalls--;
+            existing = slot;
+            slot.listener->m_pendingCalls++;
+            return;
+        }
+        i = (i + 1) & m_mask;
+    }
+
+    m_slots[i] = slot;
+    slot.listener->m_pendingCalls++;
+    m_size++;
+}
+
+const CallTable::Slot *CallTable::find(LSHandle *handle, LSMessageToken token) const
+{
+    if (token == LSMESSAGE_TOKEN_INVALID)
+        return nullptr;
+
+    int i = indexOf(handle, token);
+    return i < 0 ? nullptr : &m_slots.at(i);
+}
+
+CallTable::Slot *CallTable::find(LSHandle *handle, LSMessageToken token)
+{
+    if (token == LSMESSAGE_TOKEN_INVALID)
+        return nullptr;
+
+    int i = indexOf(handle, token);
+    return i < 0 ? nullptr : &m_slots[i];
+}
+
+const CallTable::Slot *CallTable::find(const LunaServiceManagerListener *listener, LSMessageToken token) const
+{
+    if (token == LSMESSAGE_TOKEN_INVALID || !listener || listener->m_pendingCalls == 0)
+        return nullptr;
+
+    for (int i = slotHash(token) & m_mask; ; i = (i + 1) & m_mask) {
+        const Slot &slot = m_slots.at(i);
+        if (slot.token == LSMESSAGE_TOKEN_INVALID)
+            return nullptr;
+        if (slot.token == token && slot.listener == listener)
+            return &slot;
+    }
+}
+
+bool CallTable::remove(LSHandle *handle, LSMessageToken token)
+{
+    if (token == LSMESSAGE_TOKEN_INVALID)
+        return false;
+
+    int i = indexOf(handle, token);
+    if (i < 0)
+        return false;
+
+    removeAt(i);
+    return true;
+}
+
+void CallTable::removeAt(int index)
+{
+    m_slots[index].listener->m_pendingCalls--;
+    m_size--;
+
+    // Backward shift deletion: pull later members of the probe sequence
+    // into the hole so that no tombstones are needed
+    int hole = index;
+    for (int j = (hole + 1) & m_mask; m_slots.at(j).token != LSMESSAGE_TOKEN_INVALID; j = (j + 1) & m_mask) {
+        int home = slotHash(m_slots.at(j).token) & m_mask;
+        bool movable = hole <= j ? (home <= hole || home > j) : (home <= hole && home > j);
+        if (movable) {
+            m_slots[hole] = m_slots.at(j);
+            hole = j;
+        }
+    }
+
+    m_slots[hole] = Slot();
+}
+
+QVector<CallTable::Slot> CallTable::takeAll(const LunaServiceManagerListener *listener)
+{
+    QVector<Slot> taken;
+
+    if (!listener || listener->m_pendingCalls == 0)
+        return taken;
+
+    taken.reserve(listener->m_pendingCalls);
+    int i = 0;
+    while (i < m_slots.size() && listener->m_pendingCalls > 0) {
+        if (m_slots.at(i).token != LSMESSAGE_TOKEN_INVALID && m_slots.at(i).listener == listener) {
+            taken.append(m_slots.at(i));
+            // Another slot may be shifted into i, so look at it again
+            removeAt(i);
+        } else {
+            i++;
+        }
+    }
+
+    return taken;
+}
+
+void CallTable::rehash(int capacity)
+{
+    QVector<Slot> old;
+    old.swap(m_slots);
+
+    m_slots.resize(capacity);
+    m_mask = capacity - 1;
+
+    for (const Slot &slot : old) {
+        if (slot.token == LSMESSAGE_TOKEN_INVALID)
+            continue;
+        int i = slotHash(slot.token) & m_mask;
+        while (m_slots.at(i).token != LSMESSAGE_TOKEN_INVALID)
+            i = (i + 1) & m_mask;
+        m_slots[i] = slot;
+    }
+}
@@ -0,0 +1,104 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef CALLTABLE_H
+#define CALLTABLE_H
+
+#include <QString>
+#include <QVector>
+#include <luna-service2/lunaservice.h>
+
+class LunaServiceManagerListener;
+
+    /*!
+     * \class CallTable
+     * \brief Process-wide table of the calls waiting for a reply
+     *
+     * The table is open-addressed and indexed by the call token, so
+     * finding the listener of a reply is a single probe sequence without
+     * any allocation. Tokens are only unique per LSHandle, so the handle
+     * is part of the key.
+     *
+     * Every call gets a generation number that is passed to LS2 as the
+     * callback context. A reply whose context doesn't match the
+     * generation stored in the slot belongs to a call that has been
+     * cancelled and is dropped.
+     *
+     * The table must only be used from the GUI thread.
+     *
+     * \see LunaServiceManager
+     */
+
+class CallTable
+{
+public:
+    struct Slot
+    {
+        Slot() : token(LSMESSAGE_TOKEN_INVALID), handle(nullptr), listener(nullptr), generation(0), subscription(false), method(nullptr), uri(nullptr), issuedAt(0) {}
+
+        LSMessageToken token;
+        LSHandle *handle;
+        LunaServiceManagerListener *listener;
+        quint32 generation;
+        bool subscription;
+        // Interned method name, see InternTable::name()
+        const QString *method;
+        // Interned "service/method", the key of the bus metrics
+        const char *uri;
+        // Time of the call until the first reply, only set with the bus metrics
+        qint64 issuedAt;
+    };
+
+    static CallTable *instance();
+
+    /*!
+     * \brief Returns a new generation number, never 0
+     */
+    quint32 nextGeneration();
+
+    void insert(const Slot& slot);
+
+    /*!
+     * \brief Finds the call for a reply. The returned pointer is only
+     * valid until the table is modified.
+     */
+    const Slot *find(LSHandle *handle, LSMessageToken token) const;
+    Slot *find(LSHandle *handle, LSMessageToken token);
+    const Slot *find(const LunaServiceManagerListener *listener, LSMessageToken token) const;
+
+    bool remove(LSHandle *handle, LSMessageToken token);
+
+    /*!
+     * \brief Removes and returns all the calls of the listener
+     */
+    QVector<Slot> takeAll(const LunaServiceManagerListener *listener);
+
+    int size() const { return m_size; }
+
+private:
+    CallTable();
+
+    int indexOf(LSHandle *handle, LSMessageToken token) const;
+    void removeAt(int index);
+    void rehash(int capacity);
+
+    QVector<Slot> m_slots;
+    int m_size;
+    int m_mask;
+    quint32 m_generation;
+};
+
+#endif // CALLTABLE_H
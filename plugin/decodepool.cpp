@@ -0,0 +1,309 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "decodepool.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QMap>
+#include <QSemaphore>
+#include <QThread>
+
+#include "lunaservicemgr.h"
+#include "spscring.h"
+
+// Replies of one listener with the workers at a time
+static const int s_listenerCredits = 8;
+// Replies delivered by one drain before the event loop runs again
+static const int s_deliveryBudget = 16;
+static const size_t s_workerCapacity = 64;
+
+struct DecodePool::Job : MpscNode
+{
+    quint64 queueId = 0;
+    quint64 sequence = 0;
+    QString method;
+    LunaServiceReply reply;
+    int token = 0;
+    const char *uri = nullptr;
+    // Set for a hub error, which is only kept in order
+    bool hubError = false;
+    QString error;
+};
+
+struct DecodePool::ListenerQueue
+{
+    quint64 id = 0;
+    LunaServiceManagerListener *listener = nullptr;
+    quint64 nextSequence = 0;
+    quint64 nextDelivery = 0;
+    // Jobs handed to the workers and not delivered yet
+    int inFlight = 0;
+    // Whether the queue is in m_readyQueues
+    bool ready = false;
+    QMap<quint64, Job *> decoded;
+    QQueue<Job *> waiting;
+};
+
+class DecodePool::Worker : public QThread
+{
+public:
+    Worker(DecodePool *pool, int index)
+        : m_pool(pool)
+        , m_jobs(s_workerCapacity)
+        , m_stopping(false)
+    {
+        setObjectName(QStringLiteral("LS2 decode %1").arg(index));
+    }
+
+    // GUI thread
+    bool post(Job *job)
+    {
+        if (!m_jobs.push(job))
+            return false;
+        m_wake.release();
+        return true;
+    }
+
+    // GUI thread, the jobs already posted are completed first
+    void stop()
+    {
+        m_stopping.store(true);
+        m_wake.release();
+        wait();
+    }
+
+protected:
+    void run() override
+    {
+        while (true) {
+            m_wake.acquire();
+            Job *job = nullptr;
+            while (m_jobs.pop(job)) {
+                job->reply.object();
+                m_pool->complete(job);
+            }
+            if (m_stopping.load())
+                return;
+        }
+    }
+
+private:
+    DecodePool *m_pool;
+    SpscRing<Job *> m_jobs;
+    QSemaphore m_wake;
+    std::atomic<bool> m_stopping;
+};
+
+static DecodePool *s_instance = nullptr;
+
+DecodePool *DecodePool::instance()
+{
+    if (!s_instance)
+        s_instance = new DecodePool();
+    return s_instance;
+}
+
+DecodePool *DecodePool::existing()
+{
+    return s_instance;
+}
+
+DecodePool::DecodePool()
+    : m_nextWorker(0)
+    , m_drainScheduled(false)
+    , m_nextQueueId(0)
+{
+    int threads = qgetenv("WEBOS_QML_WEBOSSERVICES_DECODE_THREADS").toInt();
+    if (threads <= 0)
+        threads = qBound(1, QThread::idealThreadCount() - 1, 4);
+
+    for (int i = 0; i < threads; ++i) {
+        Worker *worker = new Worker(this, i);
+        worker->start();
+        m_workers.append(worker);
+    }
+    qInfo() << "Replies are parsed on" << threads << "decode threads";
+
+    if (QCoreApplication *app = QCoreApplication::instance())
+        connect(app, &QCoreApplication::aboutToQuit, this, &DecodePool::shutdown);
+}
+
+DecodePool::Job *DecodePool::createJob(LunaServiceManagerListener *listener, const QString& method,
+                                       const LunaServiceReply& reply, int token, const char *uri)
+{
+    ListenerQueue *&queue = m_listeners[listener];
+    if (!queue) {
+        queue = new ListenerQueue();
+        queue->id = ++m_nextQueueId;
+        queue->listener = listener;
+        m_queues.insert(queue->id, queue);
+    }
+
+    Job *job = new Job();
+    job->queueId = queue->id;
+    job->sequence = queue->nextSequence++;
+    job->method = method;
+    job->reply = reply;
+    job->token = token;
+    job->uri = uri;
+    return job;
+}
+
+void DecodePool::submit(LunaServiceManagerListener *listener, const QString& method,
+                        const LunaServiceReply& reply, int token, const char *uri, bool decode)
+{
+    Job *job = createJob(listener, method, reply, token, uri);
+    ListenerQueue *queue = m_listeners.value(listener);
+
+    if (!decode) {
+        // Nothing to parse, it only has to wait for its turn
+        ++queue->inFlight;
+        complete(job);
+    } else if (queue->inFlight < s_listenerCredits) {
+        ++queue->inFlight;
+        dispatch(job);
+    } else {
+        queue->waiting.enqueue(job);
+    }
+}
+
+void DecodePool::submitHubError(LunaServiceManagerListener *listener, const QString& method, const QString& error,
+                                const LunaServiceReply& reply, int token, const char *uri)
+{
+    Job *job = createJob(listener, method, reply, token, uri);
+    job->hubError = true;
+    job->error = error;
+
+    ListenerQueue *queue = m_listeners.value(listener);
+    ++queue->inFlight;
+    complete(job);
+}
+
+bool DecodePool::hasPending(LunaServiceManagerListener *listener) const
+{
+    ListenerQueue *queue = m_listeners.value(listener);
+    return queue && (queue->inFlight > 0 || !queue->waiting.isEmpty());
+}
+
+void DecodePool::removeListener(LunaServiceManagerListener *listener)
+{
+    ListenerQueue *queue = m_listeners.take(listener);
+    if (!queue)
+        return;
+
+    // Jobs still with the workers are dropped by drain()
+    m_queues.remove(queue->id);
+    qDeleteAll(queue->decoded);
+    qDeleteAll(queue->waiting);
+    delete queue;
+}
+
+void DecodePool::dispatch(Job *job)
+{
+    const int count = m_workers.size();
+    for (int i = 0; i < count; ++i) {
+        Worker *worker = m_workers.at((m_nextWorker + i) % count);
+        if (worker->post(job)) {
+            m_nextWorker = (m_nextWorker + i + 1) % count;
+            return;
+        }
+    }
+
+    // Every worker is full or stopped, parse it here rather than wait
+    job->reply.object();
+    complete(job);
+}
+
+void DecodePool::complete(Job *job)
+{
+    m_decoded.push(job);
+
+    // One event per batch: nothing is posted while a drain is pending
+    if (!m_drainScheduled.exchange(true))
+        QMetaObject::invokeMethod(this, "drain", Qt::QueuedConnection);
+}
+
+void DecodePool::drain()
+{
+    // Cleared first so that a job completed after the last pop schedules a new drain
+    m_drainScheduled.store(false);
+
+    while (MpscNode *node = m_decoded.pop()) {
+        Job *job = static_cast<Job *>(node);
+        ListenerQueue *queue = m_queues.value(job->queueId);
+        if (!queue) {
+            delete job;
+            continue;
+        }
+        queue->decoded.insert(job->sequence, job);
+        if (!queue->ready && job->sequence == queue->nextDelivery) {
+            queue->ready = true;
+            m_readyQueues.enqueue(queue->id);
+        }
+    }
+
+    // One reply per listener and turn, so that a busy listener does not
+    // hold back the others
+    int budget = s_deliveryBudget;
+    while (budget > 0 && !m_readyQueues.isEmpty()) {
+        const quint64 queueId = m_readyQueues.dequeue();
+        ListenerQueue *queue = m_queues.value(queueId);
+        if (!queue)
+            continue;
+
+        queue->ready = false;
+        QMap<quint64, Job *>::iterator first = queue->decoded.begin();
+        if (first == queue->decoded.end() || first.key() != queue->nextDelivery)
+            continue;
+
+        Job *job = first.value();
+        queue->decoded.erase(first);
+        ++queue->nextDelivery;
+        --queue->inFlight;
+
+        if (!queue->waiting.isEmpty()) {
+            ++queue->inFlight;
+            dispatch(queue->waiting.dequeue());
+        }
+        if (!queue->decoded.isEmpty() && queue->decoded.firstKey() == queue->nextDelivery) {
+            queue->ready = true;
+            m_readyQueues.enqueue(queueId);
+        }
+
+        // The handler may delete the listener and with it the queue
+        LunaServiceManagerListener *listener = queue->listener;
+        if (job->hubError)
+            LunaServiceManager::deliverHubError(listener, job->method, job->error, job->reply, job->token, job->uri);
+        else
+            LunaServiceManager::deliverReply(listener, job->method, job->reply, job->token, job->uri);
+        delete job;
+        --budget;
+    }
+
+    if (!m_readyQueues.isEmpty() && !m_drainScheduled.exchange(true))
+        QMetaObject::invokeMethod(this, "drain", Qt::QueuedConnection);
+}
+
+void DecodePool::shutdown()
+{
+    // The jobs the workers still have come back through m_decoded
+    for (Worker *worker : m_workers) {
+        worker->stop();
+        delete worker;
+    }
+    m_workers.clear();
+}
@@ -0,0 +1,118 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DECODEPOOL_H
+#define DECODEPOOL_H
+
+#include <atomic>
+
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QVector>
+
+#include "lunaservicereply.h"
+#include "mpscqueue.h"
+
+class LunaServiceManagerListener;
+
+    /*!
+     * \class DecodePool
+     * \brief Parses replies on a few worker threads and hands them to their
+     * listeners on the GUI thread in the order they arrived
+     *
+     * The GUI thread gives every reply a sequence number of its listener
+     * and passes it to a worker through a lock-free ring. The workers parse
+     * in parallel and return the replies through a lock-free queue, the
+     * GUI thread holds back a reply until the ones before it for the same
+     * listener have been delivered.
+     *
+     * Flow control: a listener has at most a few replies with the workers,
+     * the rest wait on the GUI thread, and a drain delivers a bounded
+     * number of replies before the event loop gets control back.
+     *
+     * Every listener gets a queue with an id of its own. The workers only
+     * know the id, so a reply still being parsed for a deleted listener is
+     * dropped even if a new listener takes its address.
+     *
+     * The pool is created on first use, from the GUI thread only. The
+     * number of workers can be set with WEBOS_QML_WEBOSSERVICES_DECODE_THREADS.
+     * The workers are joined when the application quits, the replies
+     * after that are parsed on the GUI thread.
+     */
+
+class DecodePool : public QObject
+{
+    Q_OBJECT
+
+public:
+    static DecodePool *instance();
+
+    /*!
+     * \brief The pool if it has been created, nullptr otherwise
+     */
+    static DecodePool *existing();
+
+    /*!
+     * \brief Queues a reply for the listener, parsed by a worker if decode
+     * is true, otherwise only kept in order behind the pending ones
+     *
+     * The reply is delivered with LunaServiceManager::deliverReply().
+     */
+    void submit(LunaServiceManagerListener *listener, const QString& method,
+                const LunaServiceReply& reply, int token, const char *uri, bool decode = true);
+
+    /*!
+     * \brief Queues a hub error for the listener behind its pending replies
+     *
+     * The error is delivered with LunaServiceManager::deliverHubError().
+     */
+    void submitHubError(LunaServiceManagerListener *listener, const QString& method, const QString& error,
+                        const LunaServiceReply& reply, int token, const char *uri);
+
+    /*!
+     * \brief Whether replies of the listener are still to be delivered
+     */
+    bool hasPending(LunaServiceManagerListener *listener) const;
+
+    void removeListener(LunaServiceManagerListener *listener);
+
+private:
+    struct Job;
+    class Worker;
+    struct ListenerQueue;
+
+    DecodePool();
+
+    Job *createJob(LunaServiceManagerListener *listener, const QString& method,
+                   const LunaServiceReply& reply, int token, const char *uri);
+    void dispatch(Job *job);
+    void complete(Job *job);
+    Q_INVOKABLE void drain();
+    void shutdown();
+
+private:
+    QVector<Worker *> m_workers;
+    int m_nextWorker;
+    MpscQueue m_decoded;
+    std::atomic<bool> m_drainScheduled;
+    quint64 m_nextQueueId;
+    QHash<LunaServiceManagerListener *, ListenerQueue *> m_listeners;
+    QHash<quint64, ListenerQueue *> m_queues;
+    QQueue<quint64> m_readyQueues;
+};
+
+#endif // DECODEPOOL_H
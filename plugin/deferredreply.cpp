@@ -0,0 +1,86 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "deferredreply.h"
+
+#include <QDebug>
+
+#include "service.h"
+
+DeferredReply::DeferredReply(Service *service, LSHandle *handle, LSMessage *message,
+                             const QByteArray& subscriptionKey)
+    : QObject(service)
+    , m_service(service)
+    , m_handle(handle)
+    , m_message(message)
+    , m_subscription(LSMessageIsSubscription(message))
+    , m_method(QString::fromUtf8(LSMessageGetMethod(message)))
+    , m_subscriptionKey(subscriptionKey)
+{
+    LSMessageRef(m_message);
+}
+
+DeferredReply::~DeferredReply()
+{
+    if (!m_message)
+        return;
+
+    // The caller would wait forever otherwise
+    const int errorCodeNoReply = -1002;
+    qWarning() << "Deferred reply to" << m_method << "was never sent";
+
+    QJsonObject object;
+    object.insert(Service::strErrorCode, errorCodeNoReply);
+    object.insert(Service::strErrorText, QStringLiteral("Request was not answered"));
+    Service::sendReply(m_handle, m_message, object, nullptr);
+    LSMessageUnref(m_message);
+}
+
+bool DeferredReply::reply(const QJSValue& value)
+{
+    if (!m_message || !m_service) {
+        qWarning() << "Deferred reply to" << m_method << "was already sent";
+        return false;
+    }
+    return complete(m_service->replyObject(QVariant::fromValue(value)));
+}
+
+bool DeferredReply::fail(int errorCode, const QString& errorText)
+{
+    QJsonObject object;
+    object.insert(Service::strErrorCode, errorCode);
+    object.insert(Service::strErrorText, errorText);
+    return complete(object);
+}
+
+bool DeferredReply::complete(const QJsonObject& object)
+{
+    if (!m_message) {
+        qWarning() << "Deferred reply to" << m_method << "was already sent";
+        return false;
+    }
+
+    LSMessage *message = m_message;
+    m_message = nullptr;
+
+    // A subscription is only added while the Service is there to be told of its cancel
+    const bool sent = Service::sendReply(m_handle, message, object, m_service.data(), m_subscriptionKey);
+    LSMessageUnref(message);
+
+    emit pendingChanged();
+    deleteLater();
+    return sent;
+}
@@ -0,0 +1,100 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DEFERREDREPLY_H
+#define DEFERREDREPLY_H
+
+#include <QJSValue>
+#include <QJsonObject>
+#include <QObject>
+#include <QPointer>
+
+#include <luna-service2/lunaservice.h>
+
+class Service;
+
+    /*!
+     * \class DeferredReply
+     * \brief Reply to a request of a bus method, sent after the handler
+     * has returned
+     *
+     * Returned by Service::defer() from within a method handler. The
+     * request message is kept referenced until reply() or fail() is
+     * called, so the handler can call other services first:
+     *
+     *    function getStatus(msg) {
+     *        var pending = myService.defer();
+     *        myService.request("luna://com.webos.service.foo", "/status").then(function(status) {
+     *            pending.reply({ "status": status.value });
+     *        }, function(error) {
+     *            pending.fail(error.errorCode, error.errorText);
+     *        });
+     *    }
+     *
+     * The reply is completed like a returned one: a subscription request
+     * is added to the subscriptions of the method when the reply has no
+     * errorCode. The object belongs to the Service and deletes itself once
+     * the reply is sent. A request still pending when the Service goes
+     * away is answered with an error.
+     */
+
+class DeferredReply : public QObject
+{
+    Q_OBJECT
+    Q_PROPERTY(bool pending READ isPending NOTIFY pendingChanged)
+    Q_PROPERTY(bool subscription READ isSubscription CONSTANT)
+    Q_PROPERTY(QString method READ method CONSTANT)
+
+public:
+    DeferredReply(Service *service, LSHandle *handle, LSMessage *message,
+                  const QByteArray& subscriptionKey = QByteArray());
+    ~DeferredReply();
+
+    bool isPending() const { return m_message != nullptr; }
+    bool isSubscription() const { return m_subscription; }
+    QString method() const { return m_method; }
+
+    /*!
+     * \brief Sends the reply, an object or a JSON string as a method
+     * handler would return it
+     * \return false if the reply was already sent or could not be sent
+     */
+    Q_INVOKABLE bool reply(const QJSValue& value);
+
+    /*!
+     * \brief Sends an error reply
+     */
+    Q_INVOKABLE bool fail(int errorCode, const QString& errorText);
+
+    /*!
+     * \brief Same as reply() for C++ callers
+     */
+    bool complete(const QJsonObject& object);
+
+signals:
+    void pendingChanged();
+
+private:
+    QPointer<Service> m_service;
+    LSHandle *m_handle;
+    LSMessage *m_message;
+    bool m_subscription;
+    QString m_method;
+    // Empty for the method itself, see Service::subscriptionKeys
+    QByteArray m_subscriptionKey;
+};
+
+#endif // DEFERREDREPLY_H
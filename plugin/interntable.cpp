@@ -0,0 +1,83 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "interntable.h"
+
+#include <QHash>
+#include <QMutex>
+#include <QPair>
+
+namespace {
+
+struct String
+{
+    QString str;
+    QByteArray utf8;
+};
+
+struct Tables
+{
+    ~Tables() { qDeleteAll(strings); }
+
+    QMutex mutex;
+    QHash<QPair<QString, QString>, QByteArray> uris;
+    // Allocated one by one so that they do not move when the hash grows
+    QHash<QString, String *> strings;
+};
+
+String *intern(Tables *tables, const QString& str)
+{
+    QHash<QString, String *>::const_iterator it = tables->strings.constFind(str);
+    if (it != tables->strings.constEnd())
+        return it.value();
+
+    String *string = new String { str, str.toUtf8() };
+    tables->strings.insert(str, string);
+    return string;
+}
+
+Q_GLOBAL_STATIC(Tables, s_tables)
+
+} // namespace
+
+QByteArray InternTable::uri(const QString& service, const QString& method)
+{
+    Tables *tables = s_tables();
+    const QPair<QString, QString> key(service, method);
+
+    QMutexLocker locker(&tables->mutex);
+    QHash<QPair<QString, QString>, QByteArray>::const_iterator it = tables->uris.constFind(key);
+    if (it != tables->uris.constEnd())
+        return it.value();
+
+    return tables->uris.insert(key, (service + method).toUtf8()).value();
+}
+
+QByteArray InternTable::string(const QString& str)
+{
+    Tables *tables = s_tables();
+
+    QMutexLocker locker(&tables->mutex);
+    return intern(tables, str)->utf8;
+}
+
+const QString& InternTable::name(const QString& str)
+{
+    Tables *tables = s_tables();
+
+    QMutexLocker locker(&tables->mutex);
+    return intern(tables, str)->str;
+}
@@ -0,0 +1,62 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef INTERNTABLE_H
+#define INTERNTABLE_H
+
+#include <QByteArray>
+#include <QString>
+
+    /*!
+     * \class InternTable
+     * \brief Process-wide table of pre-encoded strings used on the bus
+     *
+     * Service URIs, method names and appIds are encoded to UTF-8 once
+     * and kept for the lifetime of the process. The returned byte arrays
+     * share their data with the table, so getting one costs a lookup and
+     * a reference count instead of an allocation, and constData() is a
+     * stable, NUL-terminated pointer that can be used as an identity.
+     * The string itself is interned next to its encoding, for the code
+     * that hands the same name to Qt over and over.
+     *
+     * Only strings from a small, bounded set should be interned; never
+     * intern payloads.
+     */
+
+class InternTable
+{
+public:
+    /*!
+     * \brief The UTF-8 encoded "service + method"
+     * (e.g. "luna://com.webos.applicationManager/launch")
+     */
+    static QByteArray uri(const QString& service, const QString& method);
+
+    /*!
+     * \brief The UTF-8 encoded string (e.g. a method name or an appId)
+     */
+    static QByteArray string(const QString& str);
+
+    /*!
+     * \brief The interned copy of the string, at a stable address
+     */
+    static const QString& name(const QString& str);
+
+private:
+    InternTable() {}
+};
+
+#endif // INTERNTABLE_H
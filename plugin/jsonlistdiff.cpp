@@ -0,0 +1,112 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "jsonlistdiff.h"
+
+#include <QHash>
+#include <QJsonObject>
+
+static const QLatin1String strIndex("index");
+static const QLatin1String strEntry("entry");
+static const QLatin1String strFrom("from");
+static const QLatin1String strTo("to");
+
+static QVariantMap indexedEntry(int index, const QJsonValue& entry)
+{
+    QVariantMap map;
+    map.insert(strIndex, index);
+    map.insert(strEntry, entry.toObject().toVariantMap());
+    return map;
+}
+
+QVector<bool> JsonListDelta::longestIncreasingRun(const QVector<int>& sequence)
+{
+    const int n = sequence.size();
+    QVector<int> tails;       // position of the last element of the best run of each length
+    QVector<int> previous(n, -1);
+    tails.reserve(n);
+
+    for (int i = 0; i < n; ++i) {
+        int low = 0, high = tails.size();
+        while (low < high) {
+            int mid = (low + high) / 2;
+            if (sequence.at(tails.at(mid)) < sequence.at(i))
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        if (low > 0)
+            previous[i] = tails.at(low - 1);
+        if (low == tails.size())
+            tails.append(i);
+        else
+            tails[low] = i;
+    }
+
+    QVector<bool> inRun(n, false);
+    for (int i = tails.isEmpty() ? -1 : tails.last(); i >= 0; i = previous.at(i))
+        inRun[i] = true;
+    return inRun;
+}
+
+JsonListDelta JsonListDelta::compute(const QJsonArray& previous, const QJsonArray& current, const QString& key)
+{
+    JsonListDelta delta;
+
+    QHash<QString, int> previousIndex;
+    previousIndex.reserve(previous.size());
+    for (int i = 0; i < previous.size(); ++i)
+        previousIndex.insert(previous.at(i).toObject().value(key).toString(), i);
+
+    // Matched objects: their index in the new list and in the old one
+    QVector<int> matchedTo;
+    QVector<int> matchedFrom;
+    QVector<bool> kept(previous.size(), false);
+
+    for (int j = 0; j < current.size(); ++j) {
+        const QJsonValue entry = current.at(j);
+        QHash<QString, int>::const_iterator it = previousIndex.constFind(entry.toObject().value(key).toString());
+        if (it == previousIndex.constEnd() || kept.at(it.value())) {
+            delta.added.append(indexedEntry(j, entry));
+            continue;
+        }
+
+        const int i = it.value();
+        kept[i] = true;
+        matchedTo.append(j);
+        matchedFrom.append(i);
+        if (previous.at(i) != entry)
+            delta.updated.append(indexedEntry(j, entry));
+    }
+
+    for (int i = 0; i < previous.size(); ++i) {
+        if (!kept.at(i))
+            delta.removed.append(indexedEntry(i, previous.at(i)));
+    }
+
+    const QVector<bool> inOrder = longestIncreasingRun(matchedFrom);
+    for (int m = 0; m < matchedFrom.size(); ++m) {
+        if (inOrder.at(m))
+            continue;
+        QVariantMap map;
+        map.insert(strFrom, matchedFrom.at(m));
+        map.insert(strTo, matchedTo.at(m));
+        map.insert(strEntry, current.at(matchedTo.at(m)).toObject().toVariantMap());
+        delta.moved.append(map);
+    }
+
+    return delta;
+}
@@ -0,0 +1,64 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef JSONLISTDIFF_H
+#define JSONLISTDIFF_H
+
+#include <QJsonArray>
+#include <QString>
+#include <QVariantList>
+#include <QVector>
+
+    /*!
+     * \class JsonListDelta
+     * \brief Changes between two versions of a list of JSON objects
+     *
+     * The entries of added and updated are {"index", "entry"} with the
+     * index in the new list, the entries of removed are {"index", "entry"}
+     * with the index in the old list and the entries of moved are
+     * {"from", "to", "entry"}. Only the changed objects are converted.
+     *
+     * \see JsonListDelta::compute()
+     */
+
+class JsonListDelta
+{
+public:
+    /*!
+     * \brief Diffs two lists whose objects are identified by the given key
+     *
+     * Objects are matched on the key, an updated object is a matched
+     * object whose content differs. The moved objects are the matched
+     * objects that are not part of the longest run kept in the same
+     * relative order, so a single move is reported as one entry rather
+     * than as a shift of everything in between.
+     */
+    static JsonListDelta compute(const QJsonArray& previous, const QJsonArray& current, const QString& key);
+
+    /*!
+     * \brief Marks the positions of a longest strictly increasing subsequence
+     */
+    static QVector<bool> longestIncreasingRun(const QVector<int>& sequence);
+
+    bool isEmpty() const { return added.isEmpty() && removed.isEmpty() && updated.isEmpty() && moved.isEmpty(); }
+
+    QVariantList added;
+    QVariantList removed;
+    QVariantList updated;
+    QVariantList moved;
+};
+
+#endif // JSONLISTDIFF_H
@@ -0,0 +1,256 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "jsonlistmodel.h"
+
+#include <QDebug>
+
+#include "jsonlistdiff.h"
+
+JsonListModel::JsonListModel(const QString& key, QObject *parent)
+    : QAbstractListModel(parent)
+    , m_key(key)
+{
+}
+
+int JsonListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : m_rows.size();
+}
+
+QVariant JsonListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= m_rows.size())
+        return QVariant();
+
+    QHash<int, QByteArray>::const_iterator it = m_roleNames.constFind(role);
+    if (it == m_roleNames.constEnd())
+        return QVariant();
+
+    return m_rows.at(index.row()).value(QLatin1String(it.value())).toVariant();
+}
+
+QHash<int, QByteArray> JsonListModel::roleNames() const
+{
+    return m_roleNames;
+}
+
+QVariantMap JsonListModel::get(int row) const
+{
+    if (row < 0 || row >= m_rows.size())
+        return QVariantMap();
+
+    return m_rows.at(row).toVariantMap();
+}
+
+int JsonListModel::indexOf(const QString& id) const
+{
+    return m_rowById.value(id, -1);
+}
+
+void JsonListModel::move(int from, int to, int count)
+{
+    if (count <= 0 || from < 0 || to < 0 || from + count > m_rows.size() || to + count > m_rows.size()) {
+        qWarning() << "JsonListModel: Invalid move from" << from << "to" << to << "count" << count;
+        return;
+    }
+    if (from == to)
+        return;
+
+    // The destination of beginMoveRows() is a row of the list before the move
+    beginMoveRows(QModelIndex(), from, from + count - 1, QModelIndex(), to > from ? to + count : to);
+    if (to > from) {
+        for (int i = 0; i < count; ++i)
+            m_rows.move(from, to + count - 1);
+    } else {
+        for (int i = 0; i < count; ++i)
+            m_rows.move(from + i, to + i);
+    }
+    reindex(qMin(from, to), qMax(from, to) + count - 1);
+    endMoveRows();
+}
+
+void JsonListModel::remove(int row, int count)
+{
+    if (count <= 0 || row < 0 || row + count > m_rows.size()) {
+        qWarning() << "JsonListModel: Invalid remove at" << row << "count" << count;
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row + count - 1);
+    for (int i = row; i < row + count; ++i)
+        m_rowById.remove(idOf(m_rows.at(i)));
+    m_rows.remove(row, count);
+    reindex(row, m_rows.size() - 1);
+    endRemoveRows();
+
+    Q_EMIT countChanged();
+}
+
+void JsonListModel::setRows(const QVector<QJsonObject>& rows)
+{
+    const int previousCount = m_rows.size();
+
+    QVector<QJsonObject> target;
+    QHash<QString, int> targetIndex;
+    target.reserve(rows.size());
+    targetIndex.reserve(rows.size());
+    for (const QJsonObject& object : rows) {
+        const QString id = idOf(object);
+        if (id.isEmpty() || targetIndex.contains(id)) {
+            qWarning() << "JsonListModel: Dropping an object without a unique" << m_key << ":" << id;
+            continue;
+        }
+        targetIndex.insert(id, target.size());
+        target.append(object);
+        addRoles(object);
+    }
+
+    // Removes the rows that went away, a run of rows at once
+    bool removed = false;
+    for (int last = m_rows.size() - 1; last >= 0; ) {
+        if (targetIndex.contains(idOf(m_rows.at(last)))) {
+            --last;
+            continue;
+        }
+        int first = last;
+        while (first > 0 && !targetIndex.contains(idOf(m_rows.at(first - 1))))
+            --first;
+        beginRemoveRows(QModelIndex(), first, last);
+        m_rows.remove(first, last - first + 1);
+        endRemoveRows();
+        removed = true;
+        last = first - 1;
+    }
+    if (removed) {
+        m_rowById.clear();
+        reindex(0, m_rows.size() - 1);
+    }
+
+    // The rows kept in the same relative order stay, every other one is
+    // moved right after the row preceding it in the new list
+    QVector<int> targetOfRow(m_rows.size());
+    QVector<int> rowOfTarget(target.size(), -1);
+    for (int row = 0; row < m_rows.size(); ++row) {
+        targetOfRow[row] = targetIndex.value(idOf(m_rows.at(row)));
+        rowOfTarget[targetOfRow.at(row)] = row;
+    }
+    const QVector<bool> inOrder = JsonListDelta::longestIncreasingRun(targetOfRow);
+    QVector<bool> stays(target.size(), false);
+    for (int row = 0; row < m_rows.size(); ++row)
+        stays[targetOfRow.at(row)] = inOrder.at(row);
+
+    QString previousId;
+    for (int t = 0; t < target.size(); ++t) {
+        if (rowOfTarget.at(t) < 0)
+            continue;
+        const QString id = idOf(target.at(t));
+        if (!stays.at(t)) {
+            const int from = m_rowById.value(id);
+            const int destination = previousId.isNull() ? 0 : m_rowById.value(previousId) + 1;
+            if (from != destination) {
+                beginMoveRows(QModelIndex(), from, from, QModelIndex(), destination);
+                moveRow(from, from < destination ? destination - 1 : destination);
+                endMoveRows();
+            }
+        }
+        previousId = id;
+    }
+
+    // The rows left are in the new order, the new ones go in between
+    bool inserted = false;
+    for (int t = 0; t < target.size(); ) {
+        if (rowOfTarget.at(t) >= 0) {
+            if (m_rows.at(t) != target.at(t))
+                updateRow(t, target.at(t));
+            ++t;
+            continue;
+        }
+        int last = t;
+        while (last + 1 < target.size() && rowOfTarget.at(last + 1) < 0)
+            ++last;
+        beginInsertRows(QModelIndex(), t, last);
+        m_rows.insert(t, last - t + 1, QJsonObject());
+        for (int i = t; i <= last; ++i)
+            m_rows[i] = target.at(i);
+        endInsertRows();
+        inserted = true;
+        t = last + 1;
+    }
+    if (inserted)
+        reindex(0, m_rows.size() - 1);
+
+    if (m_rows.size() != previousCount)
+        Q_EMIT countChanged();
+}
+
+void JsonListModel::updateRow(int row, const QJsonObject& object)
+{
+    addRoles(object);
+    const QJsonObject& previous = m_rows.at(row);
+
+    QVector<int> roles;
+    for (QJsonObject::const_iterator it = object.constBegin(); it != object.constEnd(); ++it) {
+        if (previous.value(it.key()) != it.value())
+            roles.append(m_roles.value(it.key()));
+    }
+    for (QJsonObject::const_iterator it = previous.constBegin(); it != previous.constEnd(); ++it) {
+        if (!object.contains(it.key()))
+            roles.append(m_roles.value(it.key()));
+    }
+    if (roles.isEmpty())
+        return;
+
+    const QString previousId = idOf(previous);
+    m_rows[row] = object;
+    if (idOf(object) != previousId) {
+        m_rowById.remove(previousId);
+        m_rowById.insert(idOf(object), row);
+    }
+
+    const QModelIndex modelIndex = index(row);
+    Q_EMIT dataChanged(modelIndex, modelIndex, roles);
+}
+
+QString JsonListModel::idOf(const QJsonObject& object) const
+{
+    const QJsonValue id = object.value(m_key);
+    // Numeric ids, e.g. process ids, are keyed on their text
+    return id.isString() ? id.toString() : id.toVariant().toString();
+}
+
+void JsonListModel::addRoles(const QJsonObject& object)
+{
+    for (QJsonObject::const_iterator it = object.constBegin(); it != object.constEnd(); ++it) {
+        if (m_roles.contains(it.key()))
+            continue;
+        const int role = Qt::UserRole + 1 + m_roles.size();
+        m_roles.insert(it.key(), role);
+        m_roleNames.insert(role, it.key().toUtf8());
+    }
+}
+
+void JsonListModel::reindex(int first, int last)
+{
+    for (int row = first; row <= last; ++row)
+        m_rowById.insert(idOf(m_rows.at(row)), row);
+}
+
+void JsonListModel::moveRow(int from, int to)
+{
+    m_rows.move(from, to);
+    reindex(qMin(from, to), qMax(from, to));
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef JSONLISTMODEL_H
+#define JSONLISTMODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QJsonObject>
+#include <QVector>
+
+    /*!
+     * \class JsonListModel
+     * \brief List model of JSON objects identified by a key
+     *
+     * Every member of the objects is a role of the same name. The roles
+     * are collected from the rows as they arrive, a role first seen after
+     * a view has read roleNames() is only available through get().
+     *
+     * setRows() brings the model to a new list with row-level changes
+     * only: the rows that went away are removed, the rows that are not
+     * part of the longest run kept in the same relative order are moved,
+     * the new rows are inserted and the rows whose content changed are
+     * reported with dataChanged(). Views keep their delegates for
+     * everything else.
+     */
+
+class JsonListModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+Q_SIGNALS:
+    void countChanged();
+
+public:
+    explicit JsonListModel(const QString& key, QObject *parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    int count() const { return m_rows.size(); }
+    const QString& key() const { return m_key; }
+
+    /*!
+     * \brief The row as a JS object, an empty object if there is no such row
+     */
+    Q_INVOKABLE QVariantMap get(int row) const;
+
+    /*!
+     * \brief The row of the object with the given key value, -1 if there is none
+     */
+    Q_INVOKABLE int indexOf(const QString& id) const;
+
+    Q_INVOKABLE void move(int from, int to, int count = 1);
+    Q_INVOKABLE void remove(int row, int count = 1);
+
+protected:
+    /*!
+     * \brief Replaces the content of the model with the given rows
+     *
+     * Objects without a key value or with a key value already seen in
+     * the list are dropped.
+     */
+    void setRows(const QVector<QJsonObject>& rows);
+
+    void updateRow(int row, const QJsonObject& object);
+
+    const QJsonObject& rowAt(int row) const { return m_rows.at(row); }
+    const QVector<QJsonObject>& rows() const { return m_rows; }
+    QString idOf(const QJsonObject& object) const;
+
+private:
+    void addRoles(const QJsonObject& object);
+    void reindex(int first, int last);
+    void moveRow(int from, int to);
+
+private:
+    QString m_key;
+    QVector<QJsonObject> m_rows;
+    QHash<QString, int> m_rowById;
+    QHash<int, QByteArray> m_roleNames;
+    QHash<QString, int> m_roles;
+};
+
+#endif // JSONLISTMODEL_H
@@ -0,0 +1,368 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "jsonpathextractor.h"
+
+#include <cstring>
+
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+class JsonPathExtractor::Scanner
+{
+public:
+    Scanner(const JsonPathExtractor *extractor, const QByteArray& json, QVector<QJsonValue>& values)
+        : m_extractor(extractor)
+        , m_p(json.constData())
+        , m_end(json.constData() + json.size())
+        , m_values(values)
+        , m_remaining(extractor->m_size)
+    {
+    }
+
+    bool run()
+    {
+        skipSpaces();
+        return m_p < m_end && *m_p == '{' && walk(0);
+    }
+
+private:
+    void skipSpaces()
+    {
+        while (m_p < m_end && (*m_p == ' ' || *m_p == '\t' || *m_p == '\n' || *m_p == '\r'))
+            ++m_p;
+    }
+
+    // At the opening quote, leaves m_p after the closing one
+    bool skipString()
+    {
+        ++m_p;
+        while (m_p < m_end) {
+            const char *quote = static_cast<const char *>(memchr(m_p, '"', m_end - m_p));
+            if (!quote)
+                break;
+            // The quote is escaped if an odd number of backslashes precedes it
+            const char *q = quote;
+            while (q > m_p && q[-1] == '\\')
+                --q;
+            m_p = quote + 1;
+            if ((quote - q) % 2 == 0)
+                return true;
+        }
+        m_p = m_end;
+        return false;
+    }
+
+    bool skipValue()
+    {
+        if (m_p >= m_end)
+            return false;
+
+        if (*m_p == '"')
+            return skipString();
+
+        if (*m_p != '{' && *m_p != '[') {
+            while (m_p < m_end && !strchr(",}] \t\n\r", *m_p))
+                ++m_p;
+            return true;
+        }
+
+        int depth = 0;
+        while (m_p < m_end) {
+            const char c = *m_p;
+            if (c == '"') {
+                if (!skipString())
+                    return false;
+                continue;
+            }
+            ++m_p;
+            if (c == '{' || c == '[') {
+                ++depth;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // At the opening quote
+    bool readString(QString *out)
+    {
+        const char *begin = ++m_p;
+        QString result;
+        while (m_p < m_end) {
+            const char c = *m_p;
+            if (c == '"') {
+                result.append(QString::fromUtf8(begin, m_p - begin));
+                ++m_p;
+                *out = result;
+                return true;
+            }
+            if (c != '\\') {
+                ++m_p;
+                continue;
+            }
+
+            result.append(QString::fromUtf8(begin, m_p - begin));
+            if (++m_p >= m_end)
+                return false;
+            switch (*m_p++) {
+            case '"': result.append(QLatin1Char('"')); break;
+            case '\\': result.append(QLatin1Char('\\')); break;
+            case '/': result.append(QLatin1Char('/')); break;
+            case 'b': result.append(QLatin1Char('\b')); break;
+            case 'f': result.append(QLatin1Char('\f')); break;
+            case 'n': result.append(QLatin1Char('\n')); break;
+            case 'r': result.append(QLatin1Char('\r')); break;
+            case 't': result.append(QLatin1Char('\t')); break;
+            case 'u': {
+                if (m_end - m_p < 4)
+                    return false;
+                bool ok = false;
+                // A surrogate pair is two escapes, appended one after the other
+                const ushort unit = QByteArray::fromRawData(m_p, 4).toUShort(&ok, 16);
+                if (!ok)
+                    return false;
+                result.append(QChar(unit));
+                m_p += 4;
+                break;
+            }
+            default:
+                return false;
+            }
+            begin = m_p;
+        }
+        return false;
+    }
+
+    // Member names are compared as bytes unless they are escaped
+    bool readKey(QByteArray *out)
+    {
+        const char *begin = m_p + 1;
+        const char *end = begin;
+        while (end < m_end && *end != '"' && *end != '\\')
+            ++end;
+        if (end < m_end && *end == '"') {
+            *out = QByteArray::fromRawData(begin, end - begin);
+            m_p = end + 1;
+            return true;
+        }
+
+        QString key;
+        if (!readString(&key))
+            return false;
+        *out = key.toUtf8();
+        return true;
+    }
+
+    bool readValue(QJsonValue *out)
+    {
+        if (m_p >= m_end)
+            return false;
+
+        const char *begin = m_p;
+        switch (*m_p) {
+        case '"': {
+            QString string;
+            if (!readString(&string))
+                return false;
+            *out = string;
+            return true;
+        }
+        case '{':
+        case '[': {
+            if (!skipValue())
+                return false;
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(QByteArray::fromRawData(begin, m_p - begin), &error);
+            if (error.error != QJsonParseError::NoError)
+                return false;
+            *out = doc.isObject() ? QJsonValue(doc.object()) : QJsonValue(doc.array());
+            return true;
+        }
+        default:
+            break;
+        }
+
+        skipValue();
+        const QByteArray literal = QByteArray::fromRawData(begin, m_p - begin);
+        if (literal == "true") {
+            *out = true;
+        } else if (literal == "false") {
+            *out = false;
+        } else if (literal == "null") {
+            *out = QJsonValue();
+        } else {
+            bool ok = false;
+            const double number = literal.toDouble(&ok);
+            if (!ok)
+                return false;
+            *out = number;
+        }
+        return true;
+    }
+
+    // At the opening brace of the object of node
+    bool walk(int node)
+    {
+        ++m_p;
+        skipSpaces();
+        if (m_p < m_end && *m_p == '}') {
+            ++m_p;
+            return true;
+        }
+
+        while (m_p < m_end) {
+            QByteArray key;
+            if (*m_p != '"' || !readKey(&key))
+                return false;
+            skipSpaces();
+            if (m_p >= m_end || *m_p != ':')
+                return false;
+            ++m_p;
+            skipSpaces();
+
+            const int child = m_extractor->child(node, key);
+            if (child < 0) {
+                if (!skipValue())
+                    return false;
+            } else if (m_extractor->m_nodes.at(child).path >= 0) {
+                QJsonValue value;
+                if (!readValue(&value))
+                    return false;
+                found(child, value);
+            } else if (m_p < m_end && *m_p == '{') {
+                if (!walk(child))
+                    return false;
+            } else if (!skipValue()) {
+                return false;
+            }
+
+            if (m_remaining == 0)
+                return true;
+
+            skipSpaces();
+            if (m_p >= m_end)
+                return false;
+            if (*m_p == '}') {
+                ++m_p;
+                return true;
+            }
+            if (*m_p != ',')
+                return false;
+            ++m_p;
+            skipSpaces();
+        }
+        return false;
+    }
+
+    void found(int node, const QJsonValue& value)
+    {
+        if (value.isUndefined())
+            return;
+
+        const Node &n = m_extractor->m_nodes.at(node);
+        if (n.path >= 0) {
+            if (m_values.at(n.path).isUndefined())
+                --m_remaining;
+            m_values[n.path] = value;
+        }
+
+        // Paths that go on below this one
+        if (n.children.isEmpty() || !value.isObject())
+            return;
+        const QJsonObject object = value.toObject();
+        for (int child : n.children)
+            found(child, object.value(QString::fromUtf8(m_extractor->m_nodes.at(child).key)));
+    }
+
+    const JsonPathExtractor *m_extractor;
+    const char *m_p;
+    const char *m_end;
+    QVector<QJsonValue> &m_values;
+    int m_remaining;
+};
+
+JsonPathExtractor::JsonPathExtractor(const QStringList& paths)
+    : m_nodes(1)
+    , m_size(paths.size())
+{
+    for (int i = 0; i < paths.size(); ++i) {
+        int node = 0;
+        for (const QString &segment : paths.at(i).split(QLatin1Char('.'))) {
+            const QByteArray key = segment.toUtf8();
+            int next = child(node, key);
+            if (next < 0) {
+                next = m_nodes.size();
+                Node added;
+                added.key = key;
+                m_nodes.append(added);
+                m_nodes[node].children.append(next);
+            }
+            node = next;
+        }
+        if (m_nodes.at(node).path >= 0)
+            qWarning() << "Duplicate path" << paths.at(i);
+        else
+            m_nodes[node].path = i;
+    }
+}
+
+int JsonPathExtractor::child(int node, const QByteArray& key) const
+{
+    for (int child : m_nodes.at(node).children) {
+        if (m_nodes.at(child).key == key)
+            return child;
+    }
+    return -1;
+}
+
+QVector<QJsonValue> JsonPathExtractor::extract(const QByteArray& json, bool *ok) const
+{
+    QVector<QJsonValue> values(m_size, QJsonValue(QJsonValue::Undefined));
+    Scanner scanner(this, json, values);
+    const bool valid = scanner.run();
+    if (ok)
+        *ok = valid;
+    return values;
+}
+
+QVector<QJsonValue> JsonPathExtractor::extract(const QJsonObject& object) const
+{
+    QVector<QJsonValue> values(m_size, QJsonValue(QJsonValue::Undefined));
+    for (int child : m_nodes.at(0).children)
+        collect(child, object.value(QString::fromUtf8(m_nodes.at(child).key)), values);
+    return values;
+}
+
+void JsonPathExtractor::collect(int node, const QJsonValue& value, QVector<QJsonValue>& values) const
+{
+    if (value.isUndefined())
+        return;
+
+    const Node &n = m_nodes.at(node);
+    if (n.path >= 0)
+        values[n.path] = value;
+
+    if (n.children.isEmpty() || !value.isObject())
+        return;
+
+    const QJsonObject object = value.toObject();
+    for (int child : n.children)
+        collect(child, object.value(QString::fromUtf8(m_nodes.at(child).key)), values);
+}
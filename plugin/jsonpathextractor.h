@@ -0,0 +1,80 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef JSONPATHEXTRACTOR_H
+#define JSONPATHEXTRACTOR_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QStringList>
+#include <QVector>
+
+    /*!
+     * \class JsonPathExtractor
+     * \brief Reads a few values out of a JSON object without parsing all of it
+     *
+     * The paths are dotted member names from the root object, e.g.
+     * "settings.localeInfo.locales.UI", and are compiled once into a tree.
+     * extract() scans the UTF-8 bytes, skips the members that are on no
+     * path without decoding them and stops as soon as every path has
+     * been found. Only the values found are built, an object or array
+     * value is parsed on its own.
+     *
+     * The bytes after the last value found are not looked at, so a
+     * document broken there is not detected.
+     */
+
+class JsonPathExtractor
+{
+public:
+    explicit JsonPathExtractor(const QStringList& paths);
+
+    int size() const { return m_size; }
+
+    /*!
+     * \brief The values of the paths, in the order they were given,
+     * undefined for the paths that are not in the document
+     * \param ok Set to false if the bytes read are not valid JSON or the
+     * root is not an object
+     */
+    QVector<QJsonValue> extract(const QByteArray& json, bool *ok = nullptr) const;
+
+    /*!
+     * \brief Same as above for a document that has already been parsed
+     */
+    QVector<QJsonValue> extract(const QJsonObject& object) const;
+
+private:
+    struct Node
+    {
+        QByteArray key;
+        // Index of the path that ends here, -1 if none
+        int path = -1;
+        QVector<int> children;
+    };
+
+    class Scanner;
+
+    int child(int node, const QByteArray& key) const;
+    void collect(int node, const QJsonValue& value, QVector<QJsonValue>& values) const;
+
+    // m_nodes[0] is the root object
+    QVector<Node> m_nodes;
+    int m_size;
+};
+
+#endif // JSONPATHEXTRACTOR_H
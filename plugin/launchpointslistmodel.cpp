@@ -0,0 +1,443 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "launchpointslistmodel.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QJSEngine>
+#include <QJsonArray>
+#include <luna-service2/lunaservice.h>
+
+#include "applicationmanagerservice.h"
+#include "servicemodel.h"
+
+static const QLatin1String strLaunchPoints("launchPoints");
+static const QLatin1String strLaunchPointId("launchPointId");
+static const QLatin1String strId("id");
+static const QLatin1String strTitle("title");
+static const QLatin1String strPosition("position");
+static const QLatin1String strUnmovable("unmovable");
+static const QLatin1String strBgImages("bgImages");
+static const QLatin1String strBgImage("bgImage");
+static const QLatin1String strChange("change");
+static const QLatin1String strChangeAdded("added");
+static const QLatin1String strChangeRemoved("removed");
+static const QLatin1String strChangeUpdated("updated");
+static const QLatin1String strCaseDetail("caseDetail");
+static const QLatin1String strCode("code");
+
+static PmLogContext launcherLogContext()
+{
+    static PmLogContext s_context = nullptr;
+    if (!s_context)
+        PmLogGetContext("LSM", &s_context);
+    return s_context;
+}
+
+// Launch points used to be ListModel rows, where an array of strings had to
+// become a list of objects: bgImages stays a list of {"bgImage"} objects
+static QJsonObject normalized(QJsonObject launchPoint)
+{
+    const QJsonValue bgImages = launchPoint.value(strBgImages);
+    if (!bgImages.isArray())
+        return launchPoint;
+
+    QJsonArray images;
+    for (const QJsonValue& image : bgImages.toArray()) {
+        if (!image.isObject())
+            images.append(QJsonObject{{strBgImage, image}});
+    }
+    if (!images.isEmpty())
+        launchPoint.insert(strBgImages, images);
+    return launchPoint;
+}
+
+// caseDetail.change is a list of changes, older SAM sends a string
+static bool changeContains(const QJsonValue& change, const QString& what)
+{
+    if (change.isArray())
+        return change.toArray().contains(QJsonValue(what));
+    return change.toString().contains(what);
+}
+
+LaunchPointsListModel::LaunchPointsListModel(QObject *parent)
+    : JsonListModel(strLaunchPointId, parent)
+    , m_status(ServiceModel::Null)
+    , m_defaultNewAppsIndex(9) // default 10th position (zero-based)
+    , m_newAppsIndex(9)
+{
+}
+
+void LaunchPointsListModel::setService(ApplicationManagerService *service)
+{
+    if (m_service == service)
+        return;
+
+    if (m_service)
+        disconnect(m_service, nullptr, this, nullptr);
+
+    m_service = service;
+    if (m_service) {
+        connect(m_service, &ApplicationManagerService::launchPointsPublished,
+                this, &LaunchPointsListModel::launchPointsPublished);
+        if (m_status == ServiceModel::Null)
+            setStatus(ServiceModel::Loading);
+    }
+    Q_EMIT serviceChanged();
+}
+
+void LaunchPointsListModel::setAppOrder(const QStringList& appOrder)
+{
+    if (m_appOrder == appOrder)
+        return;
+
+    m_appOrder = appOrder;
+    Q_EMIT appOrderChanged();
+}
+
+void LaunchPointsListModel::setFilter(const QJSValue& filter)
+{
+    m_filter = filter;
+    Q_EMIT filterChanged();
+}
+
+QVariantList LaunchPointsListModel::appList() const
+{
+    QVariantList list;
+    list.reserve(m_appList.size());
+    for (const QJsonObject& launchPoint : m_appList)
+        list.append(launchPoint.toVariantMap());
+    return list;
+}
+
+void LaunchPointsListModel::setDefaultNewAppsIndex(int index)
+{
+    if (m_defaultNewAppsIndex == index)
+        return;
+
+    m_defaultNewAppsIndex = index;
+    Q_EMIT defaultNewAppsIndexChanged();
+}
+
+void LaunchPointsListModel::setNewAppsIndex(int index)
+{
+    if (m_newAppsIndex == index)
+        return;
+
+    m_newAppsIndex = index;
+    Q_EMIT newAppsIndexChanged();
+}
+
+void LaunchPointsListModel::setUpdateAppsInSameListsAt(const QString& change)
+{
+    if (m_updateAppsInSameListsAt == change)
+        return;
+
+    m_updateAppsInSameListsAt = change;
+    Q_EMIT updateAppsInSameListsAtChanged();
+}
+
+void LaunchPointsListModel::setStatus(int status)
+{
+    if (m_status == status)
+        return;
+
+    m_status = status;
+    Q_EMIT statusChanged();
+}
+
+void LaunchPointsListModel::sortApps()
+{
+    if (m_appList.isEmpty()) {
+        qWarning() << "did not get app list - nothing to sort yet.";
+        return;
+    }
+
+    if (m_appOrder.isEmpty()) {
+        qWarning() << "did not get order - nothing to sort yet.";
+        setRows(m_appList);
+        Q_EMIT sorted();
+        // NOTE: Do not commitAppOrder()
+        return;
+    }
+
+    QHash<QString, int> appById;
+    appById.reserve(m_appList.size());
+    for (int i = 0; i < m_appList.size(); ++i)
+        appById.insert(idOf(m_appList.at(i)), i);
+
+    QVector<bool> placed(m_appList.size(), false);
+    QVector<QJsonObject> sortedApps;
+    sortedApps.reserve(m_appList.size());
+    for (const QString& launchPointId : m_appOrder) {
+        QHash<QString, int>::const_iterator it = appById.constFind(launchPointId);
+        if (it == appById.constEnd()) {
+            // Launch points that went missing from the list of SAM are
+            // not stored back to the DB
+            qDebug() << "launchPoint" << launchPointId << "not in SAM launchpoint list.";
+            continue;
+        }
+        if (placed.at(it.value()))
+            continue;
+        placed[it.value()] = true;
+        sortedApps.append(m_appList.at(it.value()));
+    }
+    qDebug() << "sorted" << sortedApps.size() << "launchPoints";
+
+    // Launch points that are not in the stored order go to newAppsIndex
+    int indexToInsert = qBound(0, m_newAppsIndex, sortedApps.size());
+    for (int i = 0; i < m_appList.size(); ++i) {
+        if (placed.at(i))
+            continue;
+        qDebug() << "app not in db8 sort list:" << idOf(m_appList.at(i));
+        sortedApps.insert(indexToInsert++, m_appList.at(i));
+    }
+
+    setRows(sortedApps);
+    Q_EMIT sorted();
+
+    commitAppOrder(); // sync to database to preserve current order (and forget removed items)
+}
+
+void LaunchPointsListModel::commitAppOrder(const QVariant& useredit)
+{
+    QStringList order;
+    order.reserve(count());
+    for (const QJsonObject& launchPoint : rows())
+        order.append(idOf(launchPoint));
+
+    setAppOrder(order);
+    Q_EMIT appOrderCommitted(order, useredit);
+}
+
+void LaunchPointsListModel::resetAppOrder()
+{
+    qDebug() << "resetting order";
+    setAppOrder(QStringList());
+    Q_EMIT appOrderCommitted(QStringList(), QVariant(false));
+}
+
+int LaunchPointsListModel::validPosition(const QVariant& position, int minValue, int maxValue) const
+{
+    if (minValue < 0)
+        minValue = 0;
+    if (maxValue > count())
+        maxValue = count();
+
+    if (!position.isValid()) {
+        if (m_defaultNewAppsIndex < minValue)
+            return minValue;
+        if (m_defaultNewAppsIndex > maxValue)
+            return maxValue;
+        return m_defaultNewAppsIndex;
+    }
+
+    bool ok = false;
+    int pos = int(position.toDouble(&ok));
+    if (!ok)
+        pos = m_defaultNewAppsIndex;
+
+    if (pos < minValue || pos >= maxValue)
+        return maxValue;
+
+    while (pos < maxValue && rowAt(pos).value(strUnmovable).toBool())
+        ++pos;
+    return pos;
+}
+
+QVector<QJsonObject> LaunchPointsListModel::filtered(const QJsonArray& launchPoints)
+{
+    QJSEngine *engine = m_filter.isCallable() ? qjsEngine(this) : nullptr;
+
+    QVector<QJsonObject> list;
+    list.reserve(launchPoints.size());
+    for (const QJsonValue& value : launchPoints) {
+        const QJsonObject launchPoint = value.toObject();
+        if (engine && !m_filter.call(QJSValueList() << engine->toScriptValue(launchPoint.toVariantMap())).toBool())
+            continue;
+        list.append(normalized(launchPoint));
+    }
+    return list;
+}
+
+int LaunchPointsListModel::appListIndexOf(const QString& launchPointId) const
+{
+    for (int i = 0; i < m_appList.size(); ++i) {
+        if (idOf(m_appList.at(i)) == launchPointId)
+            return i;
+    }
+    return -1;
+}
+
+void LaunchPointsListModel::launchPointsPublished(const QJsonObject& reply, bool changed)
+{
+    if (!changed) {
+        const QJsonObject caseDetail = reply.value(strCaseDetail).toObject();
+        if (caseDetail.contains(strChange) && changeContains(caseDetail.value(strChange), m_updateAppsInSameListsAt)) {
+            qDebug() << "update contents of the appList with given same app lists when res.caseDetail.changes includes updateAppsInSameListsAt";
+            m_appList = filtered(reply.value(strLaunchPoints).toArray());
+            Q_EMIT appListChanged();
+            sortApps();
+        }
+        return;
+    }
+
+    bool updateByLocaleChanged = false;
+    bool updatedInPlace = false;
+
+    if (!reply.contains(strLaunchPoints)) {
+        // SAM may send differences between old and new app info
+        if (!applyChange(reply))
+            return;
+    } else {
+        // SAM sends the full list *only* when:
+        // 1) changed service country setting
+        // 2) changed broadcast country setting
+        // 3) changed language
+        // 4) as the first response of listLaunchPoints request
+        // For #1 and #2, we need to reset lp ordering with the full list.
+        // For #3 and #4, we should keep lp ordering in db if exists.
+        // So in this case we merge the full list with the lp ordering in db.
+        const QVector<QJsonObject> appList = filtered(reply.value(strLaunchPoints).toArray());
+
+        bool needResetOrder = false;
+        const QJsonObject caseDetail = reply.value(strCaseDetail).toObject();
+        if (caseDetail.contains(strChange)) {
+            const QJsonValue change = caseDetail.value(strChange);
+            if (changeContains(change, QStringLiteral("BROADCAST_COUNTRY"))
+                    || changeContains(change, QStringLiteral("SERVICE_COUNTRY"))
+                    || changeContains(change, QStringLiteral("NEWLIST_FROM_SDP")))
+                needResetOrder = true;
+            else if (changeContains(change, QStringLiteral("LANG")))
+                updateByLocaleChanged = true;
+        } else if (caseDetail.contains(strCode)) {
+            qWarning() << "Fall-back to legacy code";
+            // NOTE: Legacy code cannot distinguash between broadcast and service country.
+
+            // code    description
+            // ----    -----------
+            // 1       first return of request
+            // 1001    change of language
+            // 1002    change of country
+            // 1003    change of both language and country
+            const int code = caseDetail.value(strCode).toInt();
+            if (code == 1002 || code == 1003)
+                needResetOrder = true;
+            else if (code == 1001)
+                updateByLocaleChanged = true;
+        }
+
+        if (needResetOrder)
+            Q_EMIT resetOrderRequested();
+
+        PmLogDebug(launcherLogContext(), "LAUNCHPOINTSLIST_RECEIVED_FROM_SAM");
+
+        // Same launch points in the same order, e.g. only titles changed
+        // on a language change: no need to sort and commit the order
+        bool sameLaunchPoints = !needResetOrder && !m_filter.isCallable()
+                && !m_appList.isEmpty() && m_appList.size() == appList.size();
+        for (int i = 0; sameLaunchPoints && i < appList.size(); ++i)
+            sameLaunchPoints = idOf(m_appList.at(i)) == idOf(appList.at(i));
+
+        m_appList = appList;
+        Q_EMIT appListChanged();
+
+        if (sameLaunchPoints) {
+            qDebug() << "received app list - updating launchPoints in place.";
+            for (const QJsonObject& launchPoint : m_appList) {
+                const int row = indexOf(idOf(launchPoint));
+                if (row >= 0)
+                    updateRow(row, launchPoint);
+            }
+            updatedInPlace = true;
+            // The rows are in the order they were sorted to, but the
+            // QML side still expects to hear about it like after a sort
+            Q_EMIT sorted();
+        }
+    }
+
+    if (!updatedInPlace) {
+        qDebug() << "received app list - sorting.";
+        sortApps();
+    }
+
+    setStatus(ServiceModel::Ready);
+
+    if (updateByLocaleChanged)
+        Q_EMIT updatedByLocaleChanged();
+}
+
+bool LaunchPointsListModel::applyChange(const QJsonObject& reply)
+{
+    const QString change = reply.value(strChange).toString();
+    const QString id = reply.value(strId).toString();
+    const QString launchPointId = reply.value(strLaunchPointId).toString();
+
+    if (change == strChangeAdded || change == strChangeRemoved) {
+        // NOTE: No need to sync for "updated" case
+        commitAppOrder(); // sync to database to preserve current order (and forget removed items)
+    }
+
+    if (change == strChangeAdded) {
+        setNewAppsIndex(validPosition(reply.value(strPosition).toVariant(), 0, m_appList.size()));
+
+        qDebug() << "Add LaunchPoint :" << id;
+        PmLogInfo(launcherLogContext(), "APPADDED_TO_LAUNCHER", 2,
+                  PMLOGKS("APP_ID", qPrintable(id)),
+                  PMLOGKFV("LOCATION", "%d", m_newAppsIndex + 1), " ");
+
+        m_appList.append(normalized(reply));
+    } else if (change == strChangeRemoved) {
+        // We got "launch point removed" notification
+        qDebug() << "Remove LaunchPoint :" << id;
+        Q_EMIT markedToKill(id);
+
+        const int i = appListIndexOf(launchPointId);
+        if (i >= 0)
+            m_appList.remove(i);
+    } else if (change == strChangeUpdated) {
+        qDebug() << "Update LaunchPoint :" << id;
+        const int row = indexOf(launchPointId);
+        PmLogInfo(launcherLogContext(), "APPUPDATED_FROM_LAUNCHER", 2,
+                  PMLOGKS("APP_ID", qPrintable(id)),
+                  PMLOGKFV("LOCATION", "%d", row), " ");
+
+        if (reply.contains(strPosition) && reply.value(strPosition).toInt() != row) {
+            setNewAppsIndex(validPosition(reply.value(strPosition).toVariant(), 0, m_appList.size() - 1));
+            if (row >= 0 && row != m_newAppsIndex) {
+                move(row, m_newAppsIndex, 1);
+                commitAppOrder();
+            }
+        }
+
+        bool titleChanged = false;
+        const int i = appListIndexOf(launchPointId);
+        if (i >= 0) {
+            titleChanged = m_appList.at(i).value(strTitle) != reply.value(strTitle);
+            m_appList[i] = normalized(reply);
+        }
+
+        if (titleChanged)
+            Q_EMIT updatedByAppTitleChanged(id, reply.value(strTitle).toString());
+    } else {
+        qWarning() << "unhandled LaunchPointsList change :" << change;
+        return false;
+    }
+
+    Q_EMIT appListChanged();
+    return true;
+}
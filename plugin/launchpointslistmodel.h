@@ -0,0 +1,145 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LAUNCHPOINTSLISTMODEL_H
+#define LAUNCHPOINTSLISTMODEL_H
+
+#include <QJSValue>
+#include <QPointer>
+#include <QStringList>
+
+#include "jsonlistmodel.h"
+
+class ApplicationManagerService;
+
+    /*!
+     * \class LaunchPointsListModel
+     * \brief Launch points of com.webos.applicationManager in the order
+     * chosen by the user
+     *
+     * The model follows the listLaunchPoints subscription of the given
+     * service. The full lists and the change events of SAM are merged
+     * with appOrder, the launch point ids in the order kept in DB8, and
+     * applied to the rows with JsonListModel::setRows().
+     *
+     * Storing the order is left to QML: appOrderCommitted() is emitted
+     * whenever the order should be written back and resetOrderRequested()
+     * when the country changed and the stored order may be dropped.
+     *
+     * \see LaunchPointsModel.qml
+     */
+
+class LaunchPointsListModel : public JsonListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(ApplicationManagerService *service READ service WRITE setService NOTIFY serviceChanged)
+    Q_PROPERTY(QStringList appOrder READ appOrder WRITE setAppOrder NOTIFY appOrderChanged)
+    Q_PROPERTY(QJSValue filter READ filter WRITE setFilter NOTIFY filterChanged)
+    Q_PROPERTY(int status READ status NOTIFY statusChanged)
+    Q_PROPERTY(QVariantList appList READ appList NOTIFY appListChanged)
+    Q_PROPERTY(int defaultNewAppsIndex READ defaultNewAppsIndex WRITE setDefaultNewAppsIndex NOTIFY defaultNewAppsIndexChanged)
+    Q_PROPERTY(int newAppsIndex READ newAppsIndex WRITE setNewAppsIndex NOTIFY newAppsIndexChanged)
+    Q_PROPERTY(QString updateAppsInSameListsAt READ updateAppsInSameListsAt WRITE setUpdateAppsInSameListsAt NOTIFY updateAppsInSameListsAtChanged)
+
+Q_SIGNALS:
+    void serviceChanged();
+    void appOrderChanged();
+    void filterChanged();
+    void statusChanged();
+    void appListChanged();
+    void defaultNewAppsIndexChanged();
+    void newAppsIndexChanged();
+    void updateAppsInSameListsAtChanged();
+
+    void markedToKill(const QVariant& lpitem);
+    void updatedByLocaleChanged();
+    void updatedByAppTitleChanged(const QVariant& appId, const QVariant& newTitle);
+    void sorted();
+
+    /*!
+     * \brief The order should be stored, useredit is undefined unless given
+     * to commitAppOrder()
+     */
+    void appOrderCommitted(const QStringList& order, const QVariant& useredit);
+
+    /*!
+     * \brief The country changed, the stored order should be reset with
+     * resetAppOrder() unless the user edited it
+     */
+    void resetOrderRequested();
+
+public:
+    explicit LaunchPointsListModel(QObject *parent = nullptr);
+
+    ApplicationManagerService *service() const { return m_service; }
+    void setService(ApplicationManagerService *service);
+
+    QStringList appOrder() const { return m_appOrder; }
+    void setAppOrder(const QStringList& appOrder);
+
+    QJSValue filter() const { return m_filter; }
+    void setFilter(const QJSValue& filter);
+
+    int status() const { return m_status; }
+    QVariantList appList() const;
+
+    int defaultNewAppsIndex() const { return m_defaultNewAppsIndex; }
+    void setDefaultNewAppsIndex(int index);
+    int newAppsIndex() const { return m_newAppsIndex; }
+    void setNewAppsIndex(int index);
+
+    QString updateAppsInSameListsAt() const { return m_updateAppsInSameListsAt; }
+    void setUpdateAppsInSameListsAt(const QString& change);
+
+    /*!
+     * \brief Merges the launch points with appOrder, the ones missing from
+     * appOrder are placed at newAppsIndex
+     */
+    Q_INVOKABLE void sortApps();
+
+    Q_INVOKABLE void commitAppOrder(const QVariant& useredit = QVariant());
+    Q_INVOKABLE void resetAppOrder();
+
+    /*!
+     * \brief Clamps a position requested by SAM to [minValue, maxValue]
+     * skipping the unmovable launch points, defaultNewAppsIndex if the
+     * position is undefined
+     */
+    Q_INVOKABLE int validPosition(const QVariant& position, int minValue, int maxValue) const;
+
+private slots:
+    void launchPointsPublished(const QJsonObject& reply, bool changed);
+
+private:
+    bool applyChange(const QJsonObject& reply);
+    void setStatus(int status);
+    QVector<QJsonObject> filtered(const QJsonArray& launchPoints);
+    int appListIndexOf(const QString& launchPointId) const;
+
+private:
+    QPointer<ApplicationManagerService> m_service;
+    // Launch points of SAM, normalized and filtered
+    QVector<QJsonObject> m_appList;
+    QStringList m_appOrder;
+    QJSValue m_filter;
+    int m_status;
+    int m_defaultNewAppsIndex;
+    int m_newAppsIndex;
+    QString m_updateAppsInSameListsAt;
+};
+
+#endif // LAUNCHPOINTSLISTMODEL_H
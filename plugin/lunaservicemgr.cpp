@@ -25,56 +25,123 @@
 #include <QCoreApplication>
 #include <QJsonDocument>
 #include <QJsonObject>
-#include <QPointer>
 #include "LSUtils.h"
+#include "interntable.h"
+#include "busthread.h"
+#include "subscriptionmux.h"
+#include "callbatch.h"
+#include "busmetrics.h"
+#include "decodepool.h"
+#include "offloadpolicy.h"
 
 namespace {
 
-static QHash<void *, QPointer<LunaServiceManagerListener> > s_callbackContext;
-
 /**
 * @brief Internal callback for service responses.
 *
+* In the bus thread mode this runs on the bus thread: the reply is copied
+* and parsed there and queued for the GUI thread, which does the lookup
+* and the dispatch. Otherwise the reply is dispatched right away.
+*
 * @param  sh
 * @param  reply
-* @param  ctx
+* @param  ctx    generation of the call in CallTable
 *
 * @retval
 */
 
 bool message_filter(LSHandle *sh, LSMessage *reply, void *ctx)
 {
-    Q_UNUSED(sh)
-
-    QString payload(LSMessageGetPayload(reply));
+    BusReply busReply;
+    busReply.handle = sh;
+    busReply.token = LSMessageGetResponseToken(reply);
+    busReply.generation = (quint32) reinterpret_cast<quintptr>(ctx);
+    busReply.hubError = LSMessageIsHubErrorMessage(reply);
+    if (busReply.hubError)
+        busReply.hubErrorMethod = QString(LSMessageGetMethod(reply));
+    // Parsed at most once, on demand, and shared by every consumer of this
+    // reply. The payload stays in the message, which is kept alive with it.
+    busReply.reply = LunaServiceReply(reply);
+
+    BusThread *busThread = BusThread::instance();
+    if (busThread && QThread::currentThread() == busThread) {
+        busReply.reply.object();
+        busThread->post(busReply);
+        return true;
+    }
 
-    LSMessageToken token = LSMessageGetResponseToken(reply);
-    LunaServiceManagerListener *listener = s_callbackContext.value(ctx).data();
+    return LunaServiceManager::dispatchReply(busReply);
+}
 
-    if (listener == NULL || !listener->callInfos.contains(token)) {
-        qWarning("Service Manager callback context is invalid: %p or token is invalid: %lu", ctx, token);
-        return false;
+inline int skipSpaces(const QChar *p, int i, int n)
+{
+    while (i < n) {
+        const ushort c = p[i].unicode();
+        if (c != ' ' && c != '\t' && c != '\n' && c != '\r')
+            break;
+        ++i;
     }
+    return i;
+}
 
-    if (token > INT_MAX) {
-        qWarning() << "token is not a valid number: " << token;
-        return false;
+// Returns the position right after the string that starts at p[i]
+inline int skipString(const QChar *p, int i, int n)
+{
+    for (++i; i < n; ++i) {
+        const ushort c = p[i].unicode();
+        if (c == '\\')
+            ++i;
+        else if (c == '"')
+            return i + 1;
     }
+    return n;
+}
 
-    int int_token = (int) token;
-
-    CallInfo call = listener->callInfos[token];
-
-    if (LSMessageIsHubErrorMessage(reply))
-        listener->hubError(call.method, QString(LSMessageGetMethod(reply)), payload, int_token);
-    else {
-        listener->serviceResponse(call.method, QString(payload), int_token);
+// Returns the position right after the value that starts at p[i]
+int skipValue(const QChar *p, int i, int n)
+{
+    if (i >= n)
+        return n;
+
+    ushort c = p[i].unicode();
+    if (c == '"')
+        return skipString(p, i, n);
+
+    if (c == '{' || c == '[') {
+        int depth = 0;
+        while (i < n) {
+            c = p[i].unicode();
+            if (c == '"') {
+                i = skipString(p, i, n);
+                continue;
+            }
+            if (c == '{' || c == '[')
+                ++depth;
+            else if ((c == '}' || c == ']') && --depth == 0)
+                return i + 1;
+            ++i;
+        }
+        return n;
     }
 
-    // Remove callInfo for one-reply call
-    if (!call.subscription)
-        listener->callInfos.take(token);
+    // number, true, false or null
+    while (i < n) {
+        c = p[i].unicode();
+        if (c == ',' || c == '}' || c == ']' || c == ' ' || c == '\t' || c == '\n' || c == '\r')
+            break;
+        ++i;
+    }
+    return i;
+}
 
+inline bool keyEquals(const QChar *p, int length, const QLatin1String& str)
+{
+    if (length != str.size())
+        return false;
+    for (int i = 0; i < length; ++i) {
+        if (p[i].unicode() != (uchar) str.data()[i])
+            return false;
+    }
     return true;
 }
 } // namespace
@@ -85,6 +152,46 @@ QHash<QString, LunaServiceManager*> s_instances;
 static const QLatin1String strSubscribe("subscribe");
 static const QLatin1String strWatch("watch");
 
+static const QLatin1String strLiteralTrue("true");
+
+bool LunaServiceManager::isSubscriptionPayload(const QString& payload)
+{
+    const QChar *p = payload.constData();
+    const int n = payload.size();
+
+    int i = skipSpaces(p, 0, n);
+    if (i >= n || p[i] != QLatin1Char('{'))
+        return false;
+    ++i;
+
+    while (true) {
+        i = skipSpaces(p, i, n);
+        if (i >= n || p[i] != QLatin1Char('"'))
+            return false;
+
+        const int keyBegin = i + 1;
+        i = skipString(p, i, n);
+        const int keyLength = i - 1 - keyBegin;
+
+        i = skipSpaces(p, i, n);
+        if (i >= n || p[i] != QLatin1Char(':'))
+            return false;
+        i = skipSpaces(p, i + 1, n);
+
+        const int valueBegin = i;
+        i = skipValue(p, i, n);
+
+        if ((keyEquals(p + keyBegin, keyLength, strSubscribe) || keyEquals(p + keyBegin, keyLength, strWatch))
+                && keyEquals(p + valueBegin, i - valueBegin, strLiteralTrue))
+            return true;
+
+        i = skipSpaces(p, i, n);
+        if (i >= n || p[i] != QLatin1Char(','))
+            return false;
+        ++i;
+    }
+}
+
 LunaServiceManager* LunaServiceManager::instance(const QString& appId, ClientType clientType, const QString& roleType)
 {
     if (appId.isEmpty()) {
@@ -103,6 +210,11 @@ LunaServiceManager* LunaServiceManager::instance(const QString& appId, ClientTyp
             return NULL;
         }
         instance->m_appId = appId;
+        instance->m_appIdUtf8 = InternTable::string(appId);
+
+        // Created on the GUI thread, which also runs its dump timer
+        if (BusMetrics::isEnabled())
+            BusMetrics::instance();
         instance->m_clientType = clientType;
         instance->m_roleType = roleType;
 
@@ -131,6 +243,19 @@ LunaServiceManager::LunaServiceManager(QObject *parent) :
     }
 }
 
+LunaServiceManagerListener::~LunaServiceManagerListener()
+{
+    // Drop the calls still waiting for a reply so that they are never dispatched here
+    const QVector<CallTable::Slot> calls = CallTable::instance()->takeAll(this);
+    for (const CallTable::Slot &call : calls) {
+        if (!call.handle)
+            SubscriptionMux::instance()->leave(call.token);
+    }
+
+    if (DecodePool *pool = DecodePool::existing())
+        pool->removeListener(this);
+}
+
 LunaServiceManager::~LunaServiceManager()
 {
     uninit();
@@ -156,7 +281,11 @@ bool LunaServiceManager::init()
         return false;
     }
 
-    ret = LSGmainContextAttach(busHandle, g_main_context_default(), &lserror);
+    // With the bus thread the handle is served by its context instead of the GUI thread one
+    BusThread *busThread = BusThread::instance();
+    GMainContext *context = busThread ? busThread->context() : g_main_context_default();
+
+    ret = LSGmainContextAttach(busHandle, context, &lserror);
     if (!ret) {
         qWarning("Failed at LSGmainContextAttach for %s, ERROR %d: %s (%s @ %s:%d)",
                 m_appId.toLatin1().constData(),
@@ -207,7 +336,7 @@ LSHandle* LunaServiceManager::getServiceHandle()
 
 LSMessageToken LunaServiceManager::call( const QString& service, const QString& method,
                                          const QString& payload, LunaServiceManagerListener* inListener,
-                                         const QString& sessionId
+                                         const QString& sessionId, CallFlags flags
                                        )
 {
     qDebug() << "LunaServiceManager" << service << method << payload << inListener << sessionId;
@@ -221,22 +350,32 @@ LSMessageToken LunaServiceManager::call( const QString& service, const QString&
     bool retVal;
     LSErrorSafe lserror;
     LSMessageToken token = LSMESSAGE_TOKEN_INVALID;
-    CallInfo call = {QString(), false};
+    const bool subscription = flags.testFlag(SubscriptionCall)
+            || (!flags.testFlag(OneReplyCall) && isSubscriptionPayload(payload));
 
     if (m_appId.isEmpty())
         qWarning() << "Application ID hasn't been set.";
 
-    void *key = inListener;
+    if (subscription && inListener && !flags.testFlag(ExclusiveCall) && SubscriptionMux::isEnabled())
+        return SubscriptionMux::instance()->join(this, service, method, payload, sessionId, inListener);
+
+    quint32 generation = 0;
+    void *key = NULL;
     LSFilterFunc callback = NULL;
-    if (key) {
-        s_callbackContext[key] = QPointer<LunaServiceManagerListener>(inListener);
+    if (inListener) {
+        generation = CallTable::instance()->nextGeneration();
+        key = reinterpret_cast<void *>((quintptr) generation);
         callback = message_filter;
     }
 
-    QJsonObject obj = QJsonDocument::fromJson(payload.toUtf8()).object();
-    if (obj[strSubscribe].toBool() || obj[strWatch].toBool()) {
-        call.subscription = true;
+    // Encoded once per process; only the payload is converted per call
+    const QByteArray uri = InternTable::uri(service, method);
+    const QByteArray payloadUtf8 = payload.toUtf8();
+#ifdef USE_LUNA_SERVICE2_SESSION_API
+    const QByteArray sessionIdUtf8 = sessionId.isEmpty() ? QByteArray() : InternTable::string(sessionId);
+#endif
 
+    if (subscription) {
         /* check m_appId for some serviceClient which want to use LSCallFromApplication function.
          * Note: it is possible to use custom appId with ApplicationClient also, but our Service
          * implementation doesn't allow to change appId after the registration, only set custom appId
@@ -245,22 +384,22 @@ LSMessageToken LunaServiceManager::call( const QString& service, const QString&
         if (m_clientType == ApplicationClient || m_appId.isEmpty() || m_roleType == "regular") {
 #ifdef USE_LUNA_SERVICE2_SESSION_API
             if (!sessionId.isEmpty())
-                retVal = LSCallSession(serviceHandle, (service + method).toUtf8().data(), payload.toUtf8().data(),
-                                       sessionId.toUtf8().data(), callback, key, &token, &lserror);
+                retVal = LSCallSession(serviceHandle, uri.constData(), payloadUtf8.constData(),
+                                       sessionIdUtf8.constData(), callback, key, &token, &lserror);
             else
 #endif
-                retVal = LSCall(serviceHandle, (service + method).toUtf8().data(), payload.toUtf8().data(),
+                retVal = LSCall(serviceHandle, uri.constData(), payloadUtf8.constData(),
                                 callback, key, &token, &lserror);
         } else {
 #ifdef USE_LUNA_SERVICE2_SESSION_API
             if (!sessionId.isEmpty())
-                retVal = LSCallSessionFromApplication(serviceHandle, (service + method).toUtf8().data(),
-                                                      payload.toUtf8().data(), sessionId.toUtf8().data(),
-                                                      m_appId.toUtf8().data(), callback, key, &token, &lserror);
+                retVal = LSCallSessionFromApplication(serviceHandle, uri.constData(),
+                                                      payloadUtf8.constData(), sessionIdUtf8.constData(),
+                                                      m_appIdUtf8.constData(), callback, key, &token, &lserror);
             else
 #endif
-                retVal = LSCallFromApplication(serviceHandle, (service + method).toUtf8().data(),
-                                               payload.toUtf8().data(), m_appId.toUtf8().data(),
+                retVal = LSCallFromApplication(serviceHandle, uri.constData(),
+                                               payloadUtf8.constData(), m_appIdUtf8.constData(),
                                                callback, key, &token, &lserror);
         }
     } else {
@@ -268,24 +407,24 @@ LSMessageToken LunaServiceManager::call( const QString& service, const QString&
         if (m_clientType == ApplicationClient || m_appId.isEmpty() || m_roleType == "regular") {
 #ifdef USE_LUNA_SERVICE2_SESSION_API
             if (!sessionId.isEmpty())
-                retVal = LSCallSessionOneReply(serviceHandle, (service + method).toUtf8().data(),
-                                               payload.toUtf8().data(), sessionId.toUtf8().data(),
+                retVal = LSCallSessionOneReply(serviceHandle, uri.constData(),
+                                               payloadUtf8.constData(), sessionIdUtf8.constData(),
                                                callback, key, &token, &lserror);
             else
 #endif
-                retVal = LSCallOneReply(serviceHandle, (service + method).toUtf8().data(),
-                                        payload.toUtf8().data(), callback, key, &token, &lserror);
+                retVal = LSCallOneReply(serviceHandle, uri.constData(),
+                                        payloadUtf8.constData(), callback, key, &token, &lserror);
         } else {
 #ifdef USE_LUNA_SERVICE2_SESSION_API
             if (!sessionId.isEmpty())
-                retVal = LSCallSessionFromApplicationOneReply(serviceHandle, (service + method).toUtf8().data(),
-                                                              payload.toUtf8().data(), sessionId.toUtf8().data(),
-                                                              m_appId.toUtf8().data(),
+                retVal = LSCallSessionFromApplicationOneReply(serviceHandle, uri.constData(),
+                                                              payloadUtf8.constData(), sessionIdUtf8.constData(),
+                                                              m_appIdUtf8.constData(),
                                                               callback, key, &token, &lserror);
             else
 #endif
-                retVal = LSCallFromApplicationOneReply(serviceHandle, (service + method).toUtf8().data(),
-                                                       payload.toUtf8().data(), m_appId.toUtf8().data(),
+                retVal = LSCallFromApplicationOneReply(serviceHandle, uri.constData(),
+                                                       payloadUtf8.constData(), m_appIdUtf8.constData(),
                                                        callback, key, &token, &lserror);
         }
     }
@@ -301,16 +440,27 @@ LSMessageToken LunaServiceManager::call( const QString& service, const QString&
         return LSMESSAGE_TOKEN_INVALID;
     }
 
+    if (BusMetrics::isEnabled())
+        BusMetrics::recordCall(uri.constData());
+
     if (inListener) {
-        call.method = method;
-        inListener->callInfos[token] = call;
+        CallTable::Slot call;
+        call.token = token;
+        call.handle = serviceHandle;
+        call.listener = inListener;
+        call.generation = generation;
+        call.subscription = subscription;
+        call.method = &InternTable::name(method);
+        call.uri = uri.constData();
+        call.issuedAt = BusMetrics::isEnabled() ? BusMetrics::now() : 0;
+        CallTable::instance()->insert(call);
     }
 
     return token;
 }
 
 LSMessageToken LunaServiceManager::callForApplication(const QString& service, const QString& method, const QString& payload,
-    const QString& appId, LunaServiceManagerListener* inListener)
+    const QString& appId, LunaServiceManagerListener* inListener, CallFlags flags)
 {
     if (m_clientType == ApplicationClient || m_roleType == "regular") {
         qWarning() << "Cannot call for" << service << method << "due to invalid permission for appId" << m_appId;
@@ -327,27 +477,31 @@ LSMessageToken LunaServiceManager::callForApplication(const QString& service, co
     bool retVal;
     LSErrorSafe lserror;
     LSMessageToken token = LSMESSAGE_TOKEN_INVALID;
-    CallInfo call = {QString(), false};
+    bool subscription = false;
 
     if (m_appId.isEmpty())
         qWarning() << "Application ID hasn't been set.";
 
-    void *key = inListener;
+    quint32 generation = 0;
+    void *key = NULL;
     LSFilterFunc callback = NULL;
-    if (key) {
-        s_callbackContext[key] = QPointer<LunaServiceManagerListener>(inListener);
+    if (inListener) {
+        generation = CallTable::instance()->nextGeneration();
+        key = reinterpret_cast<void *>((quintptr) generation);
         callback = message_filter;
     }
 
-    QJsonObject obj = QJsonDocument::fromJson(payload.toUtf8()).object();
-    if (obj[strSubscribe].toBool() || obj[strWatch].toBool()) {
-        call.subscription = true;
-        retVal = LSCallFromApplication(serviceHandle, (service + method).toUtf8().data(),
-                                       payload.toUtf8().data(), appId.toUtf8().data(),
+    const QByteArray uri = InternTable::uri(service, method);
+    const QByteArray appIdUtf8 = InternTable::string(appId);
+
+    if (flags.testFlag(SubscriptionCall) || (!flags.testFlag(OneReplyCall) && isSubscriptionPayload(payload))) {
+        subscription = true;
+        retVal = LSCallFromApplication(serviceHandle, uri.constData(),
+                                       payload.toUtf8().constData(), appIdUtf8.constData(),
                                        callback, key, &token, &lserror);
     } else {
-        retVal = LSCallFromApplicationOneReply(serviceHandle, (service + method).toUtf8().data(),
-                                               payload.toUtf8().data(), appId.toUtf8().data(),
+        retVal = LSCallFromApplicationOneReply(serviceHandle, uri.constData(),
+                                               payload.toUtf8().constData(), appIdUtf8.constData(),
                                                callback, key, &token, &lserror);
     }
 
@@ -363,14 +517,186 @@ LSMessageToken LunaServiceManager::callForApplication(const QString& service, co
         return LSMESSAGE_TOKEN_INVALID;
     }
 
+    if (BusMetrics::isEnabled())
+        BusMetrics::recordCall(uri.constData());
+
     if (inListener) {
-        call.method = method;
-        inListener->callInfos[token] = call;
+        CallTable::Slot call;
+        call.token = token;
+        call.handle = serviceHandle;
+        call.listener = inListener;
+        call.generation = generation;
+        call.subscription = subscription;
+        call.method = &InternTable::name(method);
+        call.uri = uri.constData();
+        call.issuedAt = BusMetrics::isEnabled() ? BusMetrics::now() : 0;
+        CallTable::instance()->insert(call);
     }
 
     return token;
 }
 
+int LunaServiceManager::callBatch(const QVector<BatchCall>& calls, LunaServiceManagerListener* inListener,
+                                  const QString& sessionId)
+{
+    static int s_lastBatchId = 0;
+
+    if (!inListener) {
+        qWarning() << "Unable to invoke a batch of" << calls.size() << "calls without a listener for appId" << m_appId;
+        return 0;
+    }
+
+    if (++s_lastBatchId <= 0)
+        s_lastBatchId = 1;
+
+    CallBatch *batch = new CallBatch(s_lastBatchId, inListener, calls.size());
+
+    for (int i = 0; i < calls.size(); i++) {
+        const BatchCall &batchCall = calls.at(i);
+        LSMessageToken token = call(batchCall.service, batchCall.method, batchCall.payload,
+                                    batch, sessionId, OneReplyCall);
+        batch->setIssued(i, batchCall.method, token);
+
+        if (token != LSMESSAGE_TOKEN_INVALID && batchCall.timeout >= 0)
+            setTimeout(token, batchCall.timeout);
+    }
+
+    batch->finishIssuing();
+
+    return s_lastBatchId;
+}
+
+bool LunaServiceManager::dispatchReply(const BusReply& busReply)
+{
+    CallTable *callTable = CallTable::instance();
+    CallTable::Slot *call = callTable->find(busReply.handle, busReply.token);
+
+    if (!call || call->generation != busReply.generation) {
+        qWarning("Service Manager callback context is invalid: %u or token is invalid: %lu", busReply.generation, busReply.token);
+        return false;
+    }
+
+    if (busReply.token > INT_MAX) {
+        qWarning() << "token is not a valid number: " << busReply.token;
+        return false;
+    }
+
+    int int_token = (int) busReply.token;
+
+    LunaServiceManagerListener *listener = call->listener;
+    const QString &method = *call->method;
+    const bool subscription = call->subscription;
+
+    const bool metrics = BusMetrics::isEnabled();
+    const char *uri = call->uri;
+    if (metrics) {
+        qint64 latency = -1;
+        if (call->issuedAt) {
+            latency = BusMetrics::now() - call->issuedAt;
+            call->issuedAt = 0;
+        }
+        BusMetrics::recordReply(uri, busReply.reply.payloadUtf8().size(), latency);
+
+        // Parsed already on the bus thread, or recorded by whoever parses it later
+        if (busReply.reply.isParsed())
+            BusMetrics::recordParse(uri, busReply.reply.parseTime());
+        else
+            busReply.reply.setMetricsKey(uri);
+    }
+
+    // Remove one-reply call before dispatching as the handler may modify the table.
+    // The removal moves other slots, so the call is not used past this point.
+    if (!subscription)
+        callTable->remove(busReply.handle, busReply.token);
+
+    if (busReply.hubError) {
+        routeHubError(listener, method, busReply.hubErrorMethod, busReply.reply, int_token, uri);
+        return true;
+    }
+
+    // A reply of a burst waits for the ones after it, see Service::coalescedMethods
+    if (subscription && listener->coalesceReply(method, busReply.reply, int_token, uri)) {
+        if (metrics)
+            BusMetrics::recordCoalesced(uri);
+        return true;
+    }
+
+    routeReply(listener, method, busReply.reply, int_token, uri);
+    return true;
+}
+
+void LunaServiceManager::routeReply(LunaServiceManagerListener *listener, const QString& method,
+                                    const LunaServiceReply& reply, int token, const char *uri)
+{
+    // Heavy replies are parsed on the DecodePool, the later replies of the
+    // same listener queue up behind them
+    if (!reply.isParsed() && (listener->offloadReplies(method)
+            || (uri && OffloadPolicy::isEnabled() && OffloadPolicy::instance()->shouldOffload(uri, reply.payloadUtf8().size())))) {
+        if (BusMetrics::isEnabled())
+            BusMetrics::recordOffload(uri);
+        DecodePool::instance()->submit(listener, method, reply, token, uri);
+        return;
+    }
+
+    DecodePool *pool = DecodePool::existing();
+    if (pool && pool->hasPending(listener)) {
+        pool->submit(listener, method, reply, token, uri, false);
+        return;
+    }
+
+    deliverReply(listener, method, reply, token, uri);
+}
+
+void LunaServiceManager::deliverReply(LunaServiceManagerListener *listener, const QString& method,
+                                      const LunaServiceReply& reply, int token, const char *uri)
+{
+    // Timed only for the metrics and the OffloadPolicy
+    const bool learn = uri && OffloadPolicy::isEnabled();
+    if (!learn && !BusMetrics::isEnabled()) {
+        listener->serviceResponse(method, reply, token);
+        return;
+    }
+
+    const bool parsed = reply.isParsed();
+    const qint64 start = BusMetrics::now();
+
+    listener->serviceResponse(method, reply, token);
+
+    qint64 handlerTime = BusMetrics::now() - start;
+    if (BusMetrics::isEnabled())
+        BusMetrics::recordHandler(uri, handlerTime);
+
+    // A parse done by the handler is learned on its own
+    if (!parsed && reply.isParsed())
+        handlerTime -= reply.parseTime();
+    if (learn)
+        OffloadPolicy::instance()->record(uri, reply.payloadUtf8().size(), reply.parseTime(), handlerTime);
+}
+
+void LunaServiceManager::routeHubError(LunaServiceManagerListener *listener, const QString& method, const QString& error,
+                                       const LunaServiceReply& reply, int token, const char *uri)
+{
+    // Never ahead of the replies of the listener still in the DecodePool
+    DecodePool *pool = DecodePool::existing();
+    if (pool && pool->hasPending(listener)) {
+        pool->submitHubError(listener, method, error, reply, token, uri);
+        return;
+    }
+
+    deliverHubError(listener, method, error, reply, token, uri);
+}
+
+void LunaServiceManager::deliverHubError(LunaServiceManagerListener *listener, const QString& method, const QString& error,
+                                         const LunaServiceReply& reply, int token, const char *uri)
+{
+    const qint64 start = BusMetrics::isEnabled() ? BusMetrics::now() : 0;
+
+    listener->hubError(method, error, reply, token);
+
+    if (BusMetrics::isEnabled())
+        BusMetrics::recordHandler(uri, BusMetrics::now() - start);
+}
+
 void LunaServiceManager::cancelInternal(LSHandle *sh, LSMessageToken token)
 {
     LSErrorSafe lserror;
@@ -388,16 +714,23 @@ void LunaServiceManager::cancel(LunaServiceManagerListener* inListener)
     if (!inListener)
         return;
 
-    QMap<LSMessageToken, CallInfo> &callMap = inListener->callInfos;
-    LSHandle *lshandle = getServiceHandle();
-    if (lshandle) {
-        for (auto i = callMap.begin();i != callMap.end();i = callMap.erase(i)) {
-            LSMessageToken token = i.key();
-            cancelInternal(lshandle, token);
-        }
+    const QVector<CallTable::Slot> calls = CallTable::instance()->takeAll(inListener);
+    for (const CallTable::Slot &call : calls) {
+        // Members of a shared subscription have no handle of their own
+        if (call.handle)
+            cancelInternal(call.handle, call.token);
+        else
+            SubscriptionMux::instance()->leave(call.token);
     }
 
-    s_callbackContext.remove(inListener);
+    // Batches are children of the listener that issued them
+    for (QObject *child : inListener->children()) {
+        CallBatch *batch = dynamic_cast<CallBatch *>(child);
+        if (batch) {
+            cancel(batch);
+            batch->deleteLater();
+        }
+    }
 }
 
 void LunaServiceManager::cancel(LunaServiceManagerListener* inListener, LSMessageToken token)
@@ -405,22 +738,26 @@ void LunaServiceManager::cancel(LunaServiceManagerListener* inListener, LSMessag
     if (!inListener)
         return;
 
-    QMap<LSMessageToken, CallInfo> &callMap = inListener->callInfos;
+    CallTable *callTable = CallTable::instance();
+    const CallTable::Slot *call = callTable->find(inListener, token);
 
-    if (!callMap.contains(token))
+    if (!call)
         return;
 
-    callMap.take(token);
-    LSHandle *lshandle = getServiceHandle();
+    LSHandle *lshandle = call->handle;
+    callTable->remove(lshandle, token);
     if (lshandle)
         cancelInternal(lshandle, token);
-
-    if (callMap.isEmpty())
-        s_callbackContext.remove(inListener);
+    else
+        SubscriptionMux::instance()->leave(token);
 }
 
 void LunaServiceManager::setTimeout(LSMessageToken token, int timeout)
 {
+    // The timeout of a shared subscription belongs to all of its members
+    if (SubscriptionMux::instance()->contains(token))
+        return;
+
     LSHandle *serviceHandle = getServiceHandle();
 
     if (!serviceHandle) {
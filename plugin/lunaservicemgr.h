@@ -19,13 +19,61 @@
 
 #include <QObject>
 #include <QMap>
+#include <QVector>
 #include <luna-service2/lunaservice.h>
 
+#include "lunaservicereply.h"
+#include "calltable.h"
+
+struct BusReply;
+
 enum ClientType {
     ServiceClient,
     ApplicationClient
 };
 
+/*!
+ * \brief Describes how a call is issued on the bus
+ *
+ * With AutoDetectCall the payload is scanned for a top-level
+ * "subscribe" or "watch" set to true. Callers that already know
+ * the kind of call should pass it explicitly to skip the scan.
+ *
+ * Identical subscriptions are shared unless ExclusiveCall is given.
+ */
+enum CallFlag {
+    AutoDetectCall   = 0x0,
+    OneReplyCall     = 0x1,
+    SubscriptionCall = 0x2,
+    ExclusiveCall    = 0x4
+};
+Q_DECLARE_FLAGS(CallFlags, CallFlag)
+Q_DECLARE_OPERATORS_FOR_FLAGS(CallFlags)
+
+/*!
+ * \brief One call of a batch, see LunaServiceManager::callBatch()
+ */
+struct BatchCall
+{
+    QString service;
+    QString method;
+    QString payload;
+    int timeout = -1;
+};
+
+/*!
+ * \brief Outcome of one call of a batch
+ */
+struct BatchResult
+{
+    QString method;
+    // LSMESSAGE_TOKEN_INVALID if the call could not be issued
+    LSMessageToken token = LSMESSAGE_TOKEN_INVALID;
+    LunaServiceReply reply;
+    // Set if the hub answered instead of the service
+    QString hubError;
+};
+
     /*!
      * \class LunaServiceManagerListener
      * \brief Base class for all service classes that processes replies
@@ -38,28 +86,63 @@ enum ClientType {
      * \see Service
      */
 
-typedef struct _CallInfo
-{
-    QString method;
-    bool subscription;
-} CallInfo;
-
 class LunaServiceManagerListener : public QObject
 {
 public:
     LunaServiceManagerListener(QObject * parent) : QObject(parent) { }
-    virtual ~LunaServiceManagerListener() {}
+    virtual ~LunaServiceManagerListener();
 
     /*!
      * \brief Is used to process the reply from the bus. Emits the response signal.
      */
-    virtual void serviceResponse(const QString& method, const QString& payload, int token) = 0;
+    virtual void serviceResponse(const QString& method, const LunaServiceReply& reply, int token) = 0;
+
+    virtual void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token) = 0;
+
+    /*!
+     * \brief Is used to process the replies of a batch once all of them are in.
+     * The results are in the order of the calls.
+     */
+    virtual void batchResponse(int batchId, const QVector<BatchResult>& results)
+    {
+        Q_UNUSED(batchId);
+        Q_UNUSED(results);
+    }
 
-    virtual void hubError(const QString& method, const QString& error, const QString& payload, int token) = 0;
+    /*!
+     * \brief Whether replies to the method are always parsed off the GUI
+     * thread, whatever OffloadPolicy predicts
+     */
+    virtual bool offloadReplies(const QString& method) const
+    {
+        Q_UNUSED(method);
+        return false;
+    }
+
+    /*!
+     * \brief Offers a subscription reply to be held back and delivered
+     * later with LunaServiceManager::routeReply()
+     * \return true if the listener took the reply, false to have it
+     * delivered now
+     */
+    virtual bool coalesceReply(const QString& method, const LunaServiceReply& reply, int token, const char *uri)
+    {
+        Q_UNUSED(method);
+        Q_UNUSED(reply);
+        Q_UNUSED(token);
+        Q_UNUSED(uri);
+        return false;
+    }
 
-    bool isSubscription(LSMessageToken token) { return callInfos.contains(token) && callInfos[token].subscription; }
+    bool isSubscription(LSMessageToken token)
+    {
+        const CallTable::Slot *slot = CallTable::instance()->find(this, token);
+        return slot && slot->subscription;
+    }
 
-    QMap<LSMessageToken, CallInfo> callInfos;
+private:
+    friend class CallTable;
+    int m_pendingCalls = 0;
 };
 
     /*!
@@ -106,6 +189,8 @@ public:
        from the bus.
      * \param sessionId The session id of destination
      * (e.g. "ab5f918c-8260-45c8-acdc-d056d24866a0")
+     * \param flags Whether the call is a subscription. The payload is
+     * scanned for "subscribe"/"watch" only if AutoDetectCall is given.
      * \return The token number that got assigned to this query call.
      * In the event of a malfunction "0" is returned.
      */
@@ -113,13 +198,37 @@ public:
                         const QString& method,
                         const QString& servicePayload,
                         LunaServiceManagerListener * listener,
-                        const QString& sessionId = QLatin1String(""));
+                        const QString& sessionId = QLatin1String(""),
+                        CallFlags flags = AutoDetectCall);
 
     LSMessageToken callForApplication(const QString& service,
                                       const QString& method,
                                       const QString& payload,
                                       const QString& appId,
-                                      LunaServiceManagerListener * listener);
+                                      LunaServiceManagerListener * listener,
+                                      CallFlags flags = AutoDetectCall);
+
+    /*!
+     * \brief Issues the calls back to back and tracks them as one group.
+     *
+     * Every call is a one-reply call. The replies are not dispatched one
+     * by one: listener->batchResponse() is called once with the outcome
+     * of every call when the last reply is in.
+     *
+     * \return The id of the batch, or 0 if no listener is given
+     */
+    int callBatch(const QVector<BatchCall>& calls,
+                  LunaServiceManagerListener * listener,
+                  const QString& sessionId = QLatin1String(""));
+
+    /*!
+     * \brief Tells whether a payload asks for a subscription.
+     *
+     * Only the top-level keys "subscribe" and "watch" are looked at.
+     * Nested objects, arrays and strings are skipped without being
+     * decoded, so no DOM is built and nothing is allocated.
+     */
+    static bool isSubscriptionPayload(const QString& payload);
 
     /*!
      * \brief Terminates a call causing any subscription for
@@ -139,6 +248,42 @@ public:
 
     LSHandle* getServiceHandle();
 
+    /*!
+     * \brief Delivers a reply to the listener of its call.
+     *
+     * Must be called on the GUI thread. Replies of cancelled calls
+     * are dropped.
+     */
+    static bool dispatchReply(const BusReply& reply);
+
+    /*!
+     * \brief Hands a reply to its listener, through the DecodePool if it
+     * is to be parsed off the GUI thread or other replies of the listener
+     * are still there. Without a URI the reply is neither recorded nor
+     * offloaded by the OffloadPolicy.
+     */
+    static void routeReply(LunaServiceManagerListener *listener, const QString& method,
+                           const LunaServiceReply& reply, int token, const char *uri);
+
+    /*!
+     * \brief Hands a reply to its listener and learns from the time taken
+     *
+     * Used by routeReply() and by the DecodePool for the replies it
+     * parsed. The listener may be deleted by the handler.
+     */
+    static void deliverReply(LunaServiceManagerListener *listener, const QString& method,
+                             const LunaServiceReply& reply, int token, const char *uri);
+
+    /*!
+     * \brief Hands a hub error to its listener, after the replies of the
+     * listener that are still in the DecodePool
+     */
+    static void routeHubError(LunaServiceManagerListener *listener, const QString& method, const QString& error,
+                              const LunaServiceReply& reply, int token, const char *uri);
+
+    static void deliverHubError(LunaServiceManagerListener *listener, const QString& method, const QString& error,
+                                const LunaServiceReply& reply, int token, const char *uri);
+
 private:
     /*!
      * \brief Private constructor to enforce singleton.
@@ -150,6 +295,7 @@ private:
     bool               init();
     void               uninit();
     QString            m_appId;
+    QByteArray         m_appIdUtf8;
     QString            m_roleType;
     ClientType         m_clientType;
 
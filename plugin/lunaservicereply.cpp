@@ -0,0 +1,140 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "lunaservicereply.h"
+
+#include <atomic>
+#include <mutex>
+
+#include <QJsonDocument>
+
+#include <luna-service2/lunaservice.h>
+
+#include "busmetrics.h"
+
+struct LunaServiceReply::Data
+{
+    // Holds the payload of message if set
+    LSMessage *message = nullptr;
+    QByteArray payloadUtf8;
+    QString payload;
+    std::once_flag convertOnce;
+    QJsonObject object;
+    QJsonParseError error;
+    std::once_flag parseOnce;
+    std::atomic<bool> parsed;
+    qint64 parseTime;
+    std::atomic<const char *> metricsKey;
+
+    Data() : parsed(false), parseTime(0), metricsKey(nullptr) { error.offset = 0; error.error = QJsonParseError::NoError; }
+
+    ~Data()
+    {
+        // The view must not outlive the message
+        payloadUtf8.clear();
+        if (message)
+            LSMessageUnref(message);
+    }
+
+    void parse()
+    {
+        // Always measured, the offload policy learns from it
+        const qint64 start = BusMetrics::now();
+
+        QJsonDocument doc = QJsonDocument::fromJson(payloadUtf8, &error);
+        object = doc.object();
+
+        parseTime = BusMetrics::now() - start;
+        if (BusMetrics::isEnabled())
+            BusMetrics::recordParse(metricsKey.load(std::memory_order_acquire), parseTime);
+        parsed.store(true, std::memory_order_release);
+    }
+};
+
+LunaServiceReply::LunaServiceReply()
+{
+    static QSharedPointer<Data> s_empty(new Data());
+    d = s_empty;
+}
+
+LunaServiceReply::LunaServiceReply(const QString& payload)
+    : d(new Data())
+{
+    d->payloadUtf8 = payload.toUtf8();
+}
+
+LunaServiceReply::LunaServiceReply(const QByteArray& payloadUtf8)
+    : d(new Data())
+{
+    d->payloadUtf8 = payloadUtf8;
+}
+
+LunaServiceReply::LunaServiceReply(LSMessage *message)
+    : d(new Data())
+{
+    const char *payload = LSMessageGetPayload(message);
+    if (!payload)
+        return;
+
+    LSMessageRef(message);
+    d->message = message;
+    d->payloadUtf8 = QByteArray::fromRawData(payload, qstrlen(payload));
+}
+
+const QString& LunaServiceReply::payload() const
+{
+    Data *data = d.data();
+    std::call_once(data->convertOnce, [data] () { data->payload = QString::fromUtf8(data->payloadUtf8); });
+    return data->payload;
+}
+
+const QByteArray& LunaServiceReply::payloadUtf8() const
+{
+    return d->payloadUtf8;
+}
+
+const QJsonObject& LunaServiceReply::object() const
+{
+    Data *data = d.data();
+    std::call_once(data->parseOnce, [data] () { data->parse(); });
+    return data->object;
+}
+
+const QJsonParseError& LunaServiceReply::parseError() const
+{
+    object();
+    return d->error;
+}
+
+bool LunaServiceReply::isParsed() const
+{
+    return d->parsed.load(std::memory_order_acquire);
+}
+
+qint64 LunaServiceReply::parseTime() const
+{
+    return isParsed() ? d->parseTime : 0;
+}
+
+void LunaServiceReply::setMetricsKey(const char *uri) const
+{
+    d->metricsKey.store(uri, std::memory_order_release);
+}
+
+const char *LunaServiceReply::metricsKey() const
+{
+    return d->metricsKey.load(std::memory_order_acquire);
+}
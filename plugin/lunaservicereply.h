@@ -0,0 +1,111 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef LUNASERVICEREPLY_H
+#define LUNASERVICEREPLY_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QJsonParseError>
+#include <QMetaType>
+#include <QSharedPointer>
+#include <QString>
+
+struct LSMessage;
+
+    /*!
+     * \class LunaServiceReply
+     * \brief Immutable, implicitly shared reply received from the bus
+     *
+     * A reply is created once per bus message and handed to every
+     * listener hook. The payload is parsed on the first call to object()
+     * (from whatever thread asks first) and the resulting document is
+     * shared by all later readers, so a reply is never parsed twice.
+     *
+     * The payload is kept as the UTF-8 bytes of the bus message, which is
+     * referenced rather than copied. A UTF-16 copy is only made for the
+     * consumers that ask for payload().
+     *
+     * \see LunaServiceManagerListener
+     */
+
+class LunaServiceReply
+{
+public:
+    LunaServiceReply();
+    explicit LunaServiceReply(const QString& payload);
+    explicit LunaServiceReply(const QByteArray& payloadUtf8);
+
+    /*!
+     * \brief Keeps a reference to the message and reads its payload in place
+     */
+    explicit LunaServiceReply(LSMessage *message);
+
+    /*!
+     * \brief The raw JSON reply from the bus
+     *
+     * Converted on the first call, prefer payloadUtf8() where bytes do.
+     */
+    const QString& payload() const;
+
+    /*!
+     * \brief The raw JSON reply from the bus as received, in UTF-8
+     *
+     * May point into the bus message: valid as long as the reply, copy
+     * the bytes to keep them longer.
+     */
+    const QByteArray& payloadUtf8() const;
+
+    /*!
+     * \brief The parsed root object, empty if the payload is not a JSON object
+     */
+    const QJsonObject& object() const;
+
+    /*!
+     * \brief Result of parsing the payload
+     */
+    const QJsonParseError& parseError() const;
+
+    /*!
+     * \brief True if the payload is valid JSON
+     */
+    bool isValid() const { return parseError().error == QJsonParseError::NoError; }
+
+    /*!
+     * \brief True if the payload has already been parsed
+     */
+    bool isParsed() const;
+
+    /*!
+     * \brief Time spent parsing the payload in nanoseconds, 0 until it
+     * has been parsed
+     */
+    qint64 parseTime() const;
+
+    /*!
+     * \brief Key under which a later parse is recorded in the bus metrics
+     */
+    void setMetricsKey(const char *uri) const;
+    const char *metricsKey() const;
+
+private:
+    struct Data;
+    QSharedPointer<Data> d;
+};
+
+Q_DECLARE_METATYPE(LunaServiceReply)
+
+#endif // LUNASERVICEREPLY_H
@@ -0,0 +1,96 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <atomic>
+
+#include <QtGlobal>
+
+struct MpscNode
+{
+    std::atomic<MpscNode *> next{nullptr};
+};
+
+    /*!
+     * \class MpscQueue
+     * \brief Unbounded lock-free queue for many producer threads and one
+     * consumer thread
+     *
+     * The queue is intrusive: the items derive from MpscNode and are owned
+     * by the caller. push() is wait-free. pop() may return nullptr while a
+     * producer is in the middle of a push(), the item shows up once that
+     * push() returns.
+     */
+
+class MpscQueue
+{
+public:
+    MpscQueue()
+        : m_head(&m_stub)
+        , m_tail(&m_stub)
+    {
+    }
+
+    void push(MpscNode *node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        MpscNode *previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /*!
+     * \brief Takes the oldest item, consumer thread only
+     */
+    MpscNode *pop()
+    {
+        MpscNode *tail = m_tail;
+        MpscNode *next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub) {
+            if (!next)
+                return nullptr;
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next) {
+            m_tail = next;
+            return tail;
+        }
+
+        if (tail != m_head.load(std::memory_order_acquire))
+            return nullptr;
+
+        // The last item: the stub takes its place so it can be unlinked
+        push(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next) {
+            m_tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+private:
+    Q_DISABLE_COPY(MpscQueue)
+
+    alignas(64) std::atomic<MpscNode *> m_head;
+    alignas(64) MpscNode *m_tail;
+    MpscNode m_stub;
+};
+
+#endif // MPSCQUEUE_H
@@ -66,28 +66,32 @@ void NotificationService::initSubscriptionCalls()
         if (m_tokenToastList != LSMESSAGE_TOKEN_INVALID)
             cancel(m_tokenToastList);
         m_tokenToastList = callWithRetry(serviceUri(),
-              methodGetToastNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+              methodGetToastNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+              5, SubscriptionCall);
     }
 
     if (m_alertRequested) {
         if (m_tokenAlertList != LSMESSAGE_TOKEN_INVALID)
             cancel(m_tokenAlertList);
         m_tokenAlertList = callWithRetry(serviceUri(),
-              methodGetAlertNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+              methodGetAlertNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+              5, SubscriptionCall);
     }
 
     if (m_inputAlertRequested) {
         if (m_tokenInputAlertList != LSMESSAGE_TOKEN_INVALID)
             cancel(m_tokenInputAlertList);
         m_tokenInputAlertList = callWithRetry(serviceUri(),
-              methodGetInputAlertNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+              methodGetInputAlertNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+              5, SubscriptionCall);
     }
 
     if (m_pincodePromptRequested) {
         if (m_tokenPincodePromptList != LSMESSAGE_TOKEN_INVALID)
             cancel(m_tokenPincodePromptList);
         m_tokenPincodePromptList = callWithRetry(serviceUri(),
-              methodGetPincodePromptNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+              methodGetPincodePromptNotification, QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+              5, SubscriptionCall);
     }
 }
 
@@ -98,7 +102,7 @@ QString NotificationService::toastList()
         initSubscriptionCalls();
     }
 
-    return m_toastList;
+    return m_toastList.toString();
 }
 
 QString NotificationService::alertList()
@@ -108,7 +112,7 @@ QString NotificationService::alertList()
         initSubscriptionCalls();
     }
 
-    return m_alertList;
+    return m_alertList.toString();
 }
 
 QString NotificationService::inputAlertList()
@@ -118,7 +122,7 @@ QString NotificationService::inputAlertList()
         initSubscriptionCalls();
     }
 
-    return m_inputAlertList;
+    return m_inputAlertList.toString();
 }
 
 QString NotificationService::pincodePromptList()
@@ -128,15 +132,15 @@ QString NotificationService::pincodePromptList()
         initSubscriptionCalls();
     }
 
-    return m_pincodePromptList;
+    return m_pincodePromptList.toString();
 }
 
-void NotificationService::serviceResponse(const QString& method, const QString& payload, int token)
+void NotificationService::serviceResponse(const QString& method, const LunaServiceReply& reply, int token)
 {
-    checkForErrors(payload, token);
-    Q_EMIT response(method, payload, token);
-    qDebug() << "Notification Service Response " << method << payload << token;
-    QJsonObject rootObject = QJsonDocument::fromJson(payload.toUtf8()).object();
+    checkForErrors(reply, token);
+    emitResponse(method, reply, token);
+    qDebug() << "Notification Service Response " << method << reply.payloadUtf8() << token;
+    const QJsonObject &rootObject = reply.object();
 
     uint64_t ul_token = token < 0 ? LSMESSAGE_TOKEN_INVALID : (uint64_t) token;
     if (ul_token == LSMESSAGE_TOKEN_INVALID) {
@@ -159,31 +163,27 @@ void NotificationService::serviceResponse(const QString& method, const QString&
     }
 
     if (ul_token == m_tokenToastList && method == methodGetToastNotification) {
-         if (payload == m_toastList) return;
-         m_toastList = payload;
+         if (!m_toastList.update(reply)) return;
          Q_EMIT(toastListChanged());
     }
     else if (ul_token == m_tokenAlertList && method == methodGetAlertNotification) {
-        if (payload == m_alertList) return;
-        m_alertList = payload;
+        if (!m_alertList.update(reply)) return;
         Q_EMIT(alertListChanged());
     }
     else if (ul_token == m_tokenInputAlertList && method == methodGetInputAlertNotification) {
-        if (payload == m_inputAlertList) return;
-        m_inputAlertList = payload;
+        if (!m_inputAlertList.update(reply)) return;
         Q_EMIT(inputAlertListChanged());
     }
     else if (ul_token == m_tokenPincodePromptList && method == methodGetPincodePromptNotification) {
-        if (payload == m_pincodePromptList) return;
-        m_pincodePromptList = payload;
+        if (!m_pincodePromptList.update(reply)) return;
         Q_EMIT(pincodePromptListChanged());
     }
     else qWarning() << "Unknown method";
 }
 
-void NotificationService::hubError(const QString& method, const QString& error, const QString& payload, int token)
+void NotificationService::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
 {
-    checkForErrors(payload, token);
+    checkForErrors(reply, token);
 
     if (error == LUNABUS_ERROR_SERVICE_DOWN) {
         qWarning() << "NotificationService: Hub error:" << error << "- recover subscriptions";
@@ -18,6 +18,7 @@
 #define NOTIFICATIONSERVICE_H
 
 #include "service.h"
+#include "retainedstate.h"
 #include <QUrl>
 #include <QHash>
 
@@ -70,13 +71,13 @@ protected:
      * the response signal.
      * \param method The method of the service that has been called
        (e.g. "/getPreferences")
-     * \param payload The raw JSON reply from the bus
+     * \param reply The reply from the bus
      * \param token Provides the caller's token that is answered
      * by this reply
      */
-    void serviceResponse(const QString& method, const QString& payload, int token);
+    void serviceResponse(const QString& method, const LunaServiceReply& reply, int token);
 
-    void hubError(const QString& method, const QString& error, const QString& payload, int token);
+    void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token);
 
 protected slots:
     void resetSubscription();
@@ -87,10 +88,10 @@ private:
     LSMessageToken m_tokenAlertList;
     LSMessageToken m_tokenInputAlertList;
     LSMessageToken m_tokenPincodePromptList;
-    QString m_toastList;
-    QString m_alertList;
-    QString m_inputAlertList;
-    QString m_pincodePromptList;
+    RetainedState m_toastList;
+    RetainedState m_alertList;
+    RetainedState m_inputAlertList;
+    RetainedState m_pincodePromptList;
 
     bool m_toastRequested;
     bool m_alertRequested;
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "offloadpolicy.h"
+
+#include "busmetrics.h"
+
+// Weight of a new sample in the moving averages
+static const double s_weight = 0.2;
+// Parse cost assumed before anything was measured, in ns per byte
+static const double s_initialParsePerByte = 15;
+// Below this the handoff to a worker costs about as much as it saves
+static const double s_minimumGain = 200000;
+
+bool OffloadPolicy::isEnabled()
+{
+    static const bool s_enabled = qgetenv("WEBOS_QML_WEBOSSERVICES_OFFLOAD") != "0";
+    return s_enabled;
+}
+
+OffloadPolicy *OffloadPolicy::instance()
+{
+    static OffloadPolicy *s_instance = new OffloadPolicy();
+    return s_instance;
+}
+
+OffloadPolicy::OffloadPolicy()
+    : m_parsePerByte(s_initialParsePerByte)
+{
+    bool ok = false;
+    const qint64 budget = qgetenv("WEBOS_QML_WEBOSSERVICES_OFFLOAD_BUDGET_US").toLongLong(&ok);
+    m_budget = (ok && budget > 0 ? budget : 4000) * 1000;
+}
+
+bool OffloadPolicy::shouldOffload(const char *uri, int payloadSize)
+{
+    Estimate &estimate = m_estimates[uri];
+
+    const double parsePerByte = estimate.measured ? estimate.parsePerByte : m_parsePerByte;
+    const double parseTime = parsePerByte * payloadSize * estimate.parsedShare;
+    const bool offload = parseTime + estimate.handlerTime > m_budget && parseTime > s_minimumGain;
+
+    // Counted rather than logged, a method near the budget flips often
+    if (offload != estimate.offloading) {
+        estimate.offloading = offload;
+        BusMetrics::recordOffloadSwitch(uri);
+    }
+    return offload;
+}
+
+void OffloadPolicy::record(const char *uri, int payloadSize, qint64 parseTime, qint64 handlerTime)
+{
+    Estimate &estimate = m_estimates[uri];
+
+    estimate.handlerTime += s_weight * (handlerTime - estimate.handlerTime);
+    estimate.parsedShare += s_weight * ((parseTime > 0 ? 1 : 0) - estimate.parsedShare);
+
+    if (parseTime <= 0 || payloadSize <= 0)
+        return;
+
+    const double parsePerByte = double(parseTime) / payloadSize;
+    if (estimate.measured) {
+        estimate.parsePerByte += s_weight * (parsePerByte - estimate.parsePerByte);
+    } else {
+        estimate.parsePerByte = parsePerByte;
+        estimate.measured = true;
+    }
+    m_parsePerByte += s_weight * (parsePerByte - m_parsePerByte);
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef OFFLOADPOLICY_H
+#define OFFLOADPOLICY_H
+
+#include <QHash>
+#include <QtGlobal>
+
+    /*!
+     * \class OffloadPolicy
+     * \brief Decides which replies are parsed on the DecodePool rather
+     * than on the GUI thread
+     *
+     * The policy learns per method, keyed on the interned service URI,
+     * the parse cost per byte of payload, the cost of the handler and
+     * how often the handler parses the reply at all. All are moving
+     * averages of the replies handled so far. A reply is offloaded when
+     * the predicted parse and handler cost exceeds the GUI thread budget
+     * and moving the parse saves enough to pay for the handoff.
+     *
+     * Methods without samples use the parse cost of all methods. A switch
+     * of the decision for a method is logged.
+     *
+     * The budget is WEBOS_QML_WEBOSSERVICES_OFFLOAD_BUDGET_US, 4ms by
+     * default. WEBOS_QML_WEBOSSERVICES_OFFLOAD=0 turns the policy off, the
+     * methods listed in WEBOS_QML_WEBOSSERVICES_SPREAD_METHODS are
+     * offloaded anyway. GUI thread only.
+     */
+
+class OffloadPolicy
+{
+public:
+    static bool isEnabled();
+    static OffloadPolicy *instance();
+
+    bool shouldOffload(const char *uri, int payloadSize);
+
+    /*!
+     * \brief Learns from a handled reply
+     * \param parseTime Time spent parsing, 0 if the reply was not parsed
+     * \param handlerTime Time spent in the handler, without the parse
+     */
+    void record(const char *uri, int payloadSize, qint64 parseTime, qint64 handlerTime);
+
+private:
+    OffloadPolicy();
+
+    struct Estimate
+    {
+        double parsePerByte = 0;
+        double handlerTime = 0;
+        // Share of the replies the handler parsed
+        double parsedShare = 1;
+        bool measured = false;
+        bool offloading = false;
+    };
+
+private:
+    QHash<const char *, Estimate> m_estimates;
+    double m_parsePerByte;
+    qint64 m_budget;
+};
+
+#endif // OFFLOADPOLICY_H
@@ -0,0 +1,89 @@
+# Copyright (c) 2026 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# The bridge without the QML plugin entry point, shared by the plugin
+# and the tests
+
+QT += qml
+CONFIG += c++11
+INCLUDEPATH += $$PWD
+
+config_session {
+    DEFINES += USE_LUNA_SERVICE2_SESSION_API
+}
+
+HEADERS += \
+    $$PWD/applicationmanagerservice.h \
+    $$PWD/systemservice.h \
+    $$PWD/notificationservice.h \
+    $$PWD/settingsservice.h \
+    $$PWD/service.h \
+    $$PWD/interntable.h \
+    $$PWD/lunaservicemgr.h \
+    $$PWD/lunaservicereply.h \
+    $$PWD/calltable.h \
+    $$PWD/busthread.h \
+    $$PWD/spscring.h \
+    $$PWD/mpscqueue.h \
+    $$PWD/decodepool.h \
+    $$PWD/offloadpolicy.h \
+    $$PWD/replycoalescer.h \
+    $$PWD/subscriptionmux.h \
+    $$PWD/callbatch.h \
+    $$PWD/busmetrics.h \
+    $$PWD/jsonlistdiff.h \
+    $$PWD/retainedstate.h \
+    $$PWD/jsonpathextractor.h \
+    $$PWD/deferredreply.h \
+    $$PWD/jsonlistmodel.h \
+    $$PWD/launchpointslistmodel.h \
+    $$PWD/applicationmanagermodels.h \
+    $$PWD/servicemodel.h
+
+SOURCES += \
+    $$PWD/applicationmanagerservice.cpp \
+    $$PWD/systemservice.cpp \
+    $$PWD/notificationservice.cpp \
+    $$PWD/settingsservice.cpp \
+    $$PWD/service.cpp \
+    $$PWD/interntable.cpp \
+    $$PWD/lunaservicemgr.cpp \
+    $$PWD/lunaservicereply.cpp \
+    $$PWD/calltable.cpp \
+    $$PWD/busthread.cpp \
+    $$PWD/decodepool.cpp \
+    $$PWD/offloadpolicy.cpp \
+    $$PWD/replycoalescer.cpp \
+    $$PWD/subscriptionmux.cpp \
+    $$PWD/callbatch.cpp \
+    $$PWD/busmetrics.cpp \
+    $$PWD/jsonlistdiff.cpp \
+    $$PWD/retainedstate.cpp \
+    $$PWD/jsonpathextractor.cpp \
+    $$PWD/deferredreply.cpp \
+    $$PWD/jsonlistmodel.cpp \
+    $$PWD/launchpointslistmodel.cpp \
+    $$PWD/applicationmanagermodels.cpp \
+    $$PWD/servicemodel.cpp
+
+CONFIG += link_pkgconfig
+PKGCONFIG += glib-2.0
+
+# Left out when tests/lunaservicestub/lunaservicestub.pri links the
+# stand-in instead
+!lunaservicestub {
+    PKGCONFIG += luna-service2
+}
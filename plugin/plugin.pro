@@ -22,33 +22,14 @@ TARGET = webosserviceplugin
 MOC_DIR = .moc
 OBJECTS_DIR = .obj
 
-config_session {
-    DEFINES += USE_LUNA_SERVICE2_SESSION_API
-}
+include(plugin.pri)
 
 # Input
 HEADERS += \
-    webosserviceplugin.h \
-    applicationmanagerservice.h \
-    systemservice.h \
-    notificationservice.h \
-    settingsservice.h \
-    service.h \
-    lunaservicemgr.h \
-    servicemodel.h
+    webosserviceplugin.h
 
 SOURCES += \
-    webosserviceplugin.cpp \
-    applicationmanagerservice.cpp \
-    systemservice.cpp \
-    notificationservice.cpp \
-    settingsservice.cpp \
-    service.cpp \
-    lunaservicemgr.cpp \
-    servicemodel.cpp
-
-CONFIG += link_pkgconfig
-PKGCONFIG = glib-2.0 luna-service2
+    webosserviceplugin.cpp
 
 OTHER_FILES += qmldir \
                webosserviceplugindescription.json
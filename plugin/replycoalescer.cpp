@@ -0,0 +1,128 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "replycoalescer.h"
+
+#include <QDebug>
+#include <QGuiApplication>
+#include <QJsonObject>
+#include <QJsonValue>
+#include <QPointer>
+#include <QScreen>
+
+#include "lunaservicemgr.h"
+
+static const int s_defaultFrameInterval = 16;
+
+ReplyCoalescer::ReplyCoalescer(LunaServiceManagerListener *listener)
+    : QObject(listener)
+    , m_listener(listener)
+    , m_keyPath(QStringList())
+{
+    m_timer.setSingleShot(true);
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &ReplyCoalescer::flush);
+}
+
+void ReplyCoalescer::setMethods(const QStringList& methods)
+{
+    m_methods = methods;
+
+    // Whatever is held back for a method no longer listed goes out as is
+    if (!m_held.isEmpty()) {
+        m_timer.stop();
+        flush();
+    }
+}
+
+void ReplyCoalescer::setKey(const QString& key)
+{
+    m_key = key;
+    m_keyPath = JsonPathExtractor(key.isEmpty() ? QStringList() : QStringList(key));
+}
+
+void ReplyCoalescer::setInterval(int interval)
+{
+    if (interval < 0) {
+        qWarning() << "Invalid coalesce interval" << interval << "- using one frame";
+        interval = 0;
+    }
+    m_interval = interval;
+}
+
+int ReplyCoalescer::effectiveInterval() const
+{
+    if (m_interval > 0)
+        return m_interval;
+
+    QScreen *screen = QGuiApplication::primaryScreen();
+    const qreal rate = screen ? screen->refreshRate() : 0;
+    return rate > 1 ? qMax(1, qRound(1000 / rate)) : s_defaultFrameInterval;
+}
+
+bool ReplyCoalescer::add(const QString& method, const LunaServiceReply& reply, int token, const char *uri)
+{
+    if (!m_methods.contains(method))
+        return false;
+
+    // Leading edge: the first reply of a burst is not delayed
+    if (!m_timer.isActive()) {
+        m_timer.start(effectiveInterval());
+        return false;
+    }
+
+    // Scanned out of the bytes, the reply is still to be offloaded or not
+    QString key;
+    if (!m_key.isEmpty()) {
+        const QJsonValue value = reply.isParsed() ? m_keyPath.extract(reply.object()).at(0)
+                                                  : m_keyPath.extract(reply.payloadUtf8()).at(0);
+        key = value.toVariant().toString();
+    }
+    const QPair<int, QString> id(token, key);
+
+    QHash<QPair<int, QString>, int>::const_iterator it = m_index.constFind(id);
+    if (it != m_index.constEnd()) {
+        m_held[it.value()].reply = reply;
+        return true;
+    }
+
+    m_index.insert(id, m_held.size());
+    m_held.append({method, reply, token, uri});
+    return true;
+}
+
+void ReplyCoalescer::flush()
+{
+    if (m_held.isEmpty())
+        return;
+
+    const QVector<Held> held = m_held;
+    m_held.clear();
+    m_index.clear();
+
+    // Replies that come while these are handled wait for the next interval
+    m_timer.start(effectiveInterval());
+
+    // The handler may delete the listener and with it this object
+    QPointer<ReplyCoalescer> self(this);
+    for (const Held &item : held) {
+        if (!m_listener->isSubscription(item.token))
+            continue;
+        LunaServiceManager::routeReply(m_listener, item.method, item.reply, item.token, item.uri);
+        if (!self)
+            return;
+    }
+}
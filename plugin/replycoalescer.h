@@ -0,0 +1,97 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef REPLYCOALESCER_H
+#define REPLYCOALESCER_H
+
+#include <QHash>
+#include <QObject>
+#include <QPair>
+#include <QStringList>
+#include <QTimer>
+#include <QVector>
+
+#include "jsonpathextractor.h"
+#include "lunaservicereply.h"
+
+class LunaServiceManagerListener;
+
+    /*!
+     * \class ReplyCoalescer
+     * \brief Delivers the subscription replies of a burst at most once per
+     * interval, the latest one wins
+     *
+     * A reply that comes while nothing is held back is delivered at once
+     * and opens an interval. The replies that come during the interval
+     * are held back, one per subscription and key, and a newer one
+     * replaces the one held back. At the end of the interval the held
+     * back replies are delivered in the order they first came, and a new
+     * interval opens if there were any.
+     *
+     * The key is the value of a field of the reply, e.g. "appId", so that
+     * the events of different applications are all delivered. It is read
+     * with a JsonPathExtractor, the replies are not parsed for it. The interval is one frame of the primary screen unless
+     * set. Replies of cancelled subscriptions are dropped.
+     */
+
+class ReplyCoalescer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReplyCoalescer(LunaServiceManagerListener *listener);
+
+    QStringList methods() const { return m_methods; }
+    void setMethods(const QStringList& methods);
+
+    int interval() const { return m_interval; }
+    void setInterval(int interval);
+
+    QString key() const { return m_key; }
+    void setKey(const QString& key);
+
+    /*!
+     * \brief Whether the reply is held back, see
+     * LunaServiceManagerListener::coalesceReply()
+     */
+    bool add(const QString& method, const LunaServiceReply& reply, int token, const char *uri);
+
+private slots:
+    void flush();
+
+private:
+    struct Held
+    {
+        QString method;
+        LunaServiceReply reply;
+        int token;
+        const char *uri;
+    };
+
+    int effectiveInterval() const;
+
+    LunaServiceManagerListener *m_listener;
+    QStringList m_methods;
+    int m_interval = 0;
+    QString m_key;
+    JsonPathExtractor m_keyPath;
+    QTimer m_timer;
+    QVector<Held> m_held;
+    // Index in m_held by token and key
+    QHash<QPair<int, QString>, int> m_index;
+};
+
+#endif // REPLYCOALESCER_H
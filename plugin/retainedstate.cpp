@@ -0,0 +1,85 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "retainedstate.h"
+
+#include <QJsonDocument>
+
+RetainedState::RetainedState()
+    : m_hash(0)
+    , m_empty(true)
+    , m_hasString(false)
+    , m_hasObject(false)
+{
+}
+
+quint64 RetainedState::hashPayload(const QByteArray& payload)
+{
+    quint64 hash = Q_UINT64_C(14695981039346656037);
+    const uchar *p = reinterpret_cast<const uchar *>(payload.constData());
+    const uchar *end = p + payload.size();
+    for (; p != end; ++p)
+        hash = (hash ^ *p) * Q_UINT64_C(1099511628211);
+    return hash;
+}
+
+bool RetainedState::update(const LunaServiceReply& reply)
+{
+    const quint64 hash = hashPayload(reply.payloadUtf8());
+    if (!m_empty && hash == m_hash)
+        return false;
+
+    m_hash = hash;
+    m_empty = false;
+    // A deep copy, the payload may be a view into the bus message
+    m_payload = QByteArray(reply.payloadUtf8().constData(), reply.payloadUtf8().size());
+    m_string.clear();
+    m_hasString = false;
+    // Shared rather than parsed again
+    m_hasObject = reply.isParsed();
+    m_object = m_hasObject ? reply.object() : QJsonObject();
+
+    return true;
+}
+
+void RetainedState::clear()
+{
+    m_payload.clear();
+    m_hash = 0;
+    m_empty = true;
+    m_string.clear();
+    m_object = QJsonObject();
+    m_hasString = false;
+    m_hasObject = false;
+}
+
+QString RetainedState::toString() const
+{
+    if (!m_hasString) {
+        m_string = QString::fromUtf8(m_payload);
+        m_hasString = true;
+    }
+    return m_string;
+}
+
+QJsonObject RetainedState::toObject() const
+{
+    if (!m_hasObject) {
+        m_object = QJsonDocument::fromJson(m_payload).object();
+        m_hasObject = true;
+    }
+    return m_object;
+}
@@ -0,0 +1,82 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef RETAINEDSTATE_H
+#define RETAINEDSTATE_H
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QString>
+#include <QVariant>
+
+#include "lunaservicereply.h"
+
+    /*!
+     * \class RetainedState
+     * \brief Last value of a subscription
+     *
+     * The payload is kept as the UTF-8 bytes received, together with a
+     * 64-bit hash of them. A reply that repeats the retained one is
+     * recognized by its hash without comparing the payloads. The string
+     * and the object forms are made on the first read and kept until the
+     * next update, or taken over from the reply if it was parsed already.
+     */
+
+class RetainedState
+{
+public:
+    RetainedState();
+
+    /*!
+     * \brief Retains the reply
+     * \return false if the reply is the same as the retained one
+     */
+    bool update(const LunaServiceReply& reply);
+
+    void clear();
+
+    bool isEmpty() const { return m_empty; }
+    quint64 hash() const { return m_hash; }
+
+    /*!
+     * \brief The retained payload as received, empty if nothing is retained
+     */
+    QString toString() const;
+
+    /*!
+     * \brief The retained payload parsed, empty if it is not a JSON object
+     */
+    QJsonObject toObject() const;
+    QVariant toVariant() const { return m_empty ? QVariant() : QVariant(toObject()); }
+
+    /*!
+     * \brief 64-bit FNV-1a hash of a payload
+     */
+    static quint64 hashPayload(const QByteArray& payload);
+
+private:
+    QByteArray m_payload;
+    quint64 m_hash;
+    bool m_empty;
+
+    // Made on demand, dropped by update()
+    mutable QString m_string;
+    mutable QJsonObject m_object;
+    mutable bool m_hasString;
+    mutable bool m_hasObject;
+};
+
+#endif // RETAINEDSTATE_H
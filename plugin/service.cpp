@@ -18,53 +18,64 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <memory>
 
 #include <QCoreApplication>
 #include <QGuiApplication>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QThread>
-#include <QMutex>
-#include <QQueue>
 #include <QJsonObject>
-#include <QSemaphore>
+#include <QJSEngine>
+#include <QMetaMethod>
+#include <QQmlEngine>
 
 #include "lunaservicemgr.h"
+#include "interntable.h"
+#include "busmetrics.h"
+#include "replycoalescer.h"
+#include "deferredreply.h"
 #include "LSUtils.h"
 
-class MessageSpreader: public QThread
+/*!
+ * \brief Settles the promises returned by Service::request()
+ *
+ * It is the listener of the request calls of its Service, so these replies
+ * don't go through the response signals of the Service.
+ */
+class PendingRequests : public LunaServiceManagerListener
 {
 public:
-    static MessageSpreader *instance();
-    MessageSpreader();
-    ~MessageSpreader();
-    void removeListener(MessageSpreaderListener *listener);
-    void pushMessageResponse(MessageSpreaderListener *listener, const QString& method, const QString& payload, int token);
-    void messageResponded(MessageSpreaderListener *listener);
-
-    struct Response
+    PendingRequests(Service *service) : LunaServiceManagerListener(service) {}
+
+    QJSValue add(QJSEngine *engine, LSMessageToken token);
+    bool contains(LSMessageToken token) const { return m_pending.contains((int) token); }
+    void reject(LSMessageToken token, const QString& errorText);
+    void rejectAll(const QString& errorText);
+
+    void serviceResponse(const QString& method, const LunaServiceReply& reply, int token) override;
+    void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token) override;
+
+private:
+    struct Resolvers
     {
-        QString method;
-        QString payload;
-        int token = 0;
-        MessageSpreaderListener *listener = nullptr;
-        size_t listenerHandle = 0;
+        QJSValue resolve;
+        QJSValue reject;
     };
 
-private:
-    void run() override;
-    void messageRespondedInternal(MessageSpreaderListener *listener);
-    QMutex m_mutex;
-    QSet<size_t> m_listeners;
-    QQueue<Response> m_responses;
-    QSemaphore m_semaphore;
-    uint32_t m_postSleepMs = 0;
+    void settle(int token, const QJsonObject& response);
+    static QJsonObject errorObject(const QString& errorText);
+
+    QJSEngine *m_engine = nullptr;
+    QJSValue m_deferredFactory;
+    QHash<int, Resolvers> m_pending;
 };
 
 const QLatin1String Service::strURIScheme("luna://");
 const QLatin1String Service::strURISchemeDeprecated("palm://");
 const QLatin1String Service::strReturnValue("returnValue");
 const QLatin1String Service::strSubscribe("subscribe");
+const QLatin1String Service::strWatch("watch");
 const QLatin1String Service::strSubscribed("subscribed");
 const QLatin1String Service::strErrorCode("errorCode");
 const QLatin1String Service::strErrorText("errorText");
@@ -79,6 +90,12 @@ const QLatin1String Service::strSessionId("sessionId");
 const QLatin1String Service::strPayload("payload");
 const QLatin1String Service::strCallerId("callerId");
 
+static const QLatin1String strService("service");
+static const QLatin1String strMethod("method");
+static const QLatin1String strTimeout("timeout");
+static const QLatin1String strToken("token");
+static const QLatin1String strResponse("response");
+
 Service::Service(QObject * parent)
     : LunaServiceManagerListener(parent)
     , m_serviceManager(0)
@@ -134,14 +151,19 @@ void Service::setRoleType(const QString& roleType)
 }
 
 int Service::call(const QString& service, const QString& method, const QString& payload, const QJSValue& timeout, const QString& sessionId)
+{
+    return callWithFlags(service, method, payload, AutoDetectCall, timeout, sessionId);
+}
+
+int Service::callWithFlags(const QString& service, const QString& method, const QString& payload, CallFlags flags, const QJSValue& timeout, const QString& sessionId)
 {
     QString effectiveSessionId(sessionId.isEmpty() ? m_sessionId: sessionId);
     if (effectiveSessionId == "no-session")
         effectiveSessionId = "";
-    return callInternal(service, method, payload, timeout, effectiveSessionId);
+    return callInternal(service, method, payload, timeout, effectiveSessionId, flags);
 }
 
-int Service::callInternal(const QString& service, const QString& method, const QString & payload, const QJSValue& timeout, const QString& sessionId)
+int Service::callInternal(const QString& service, const QString& method, const QString & payload, const QJSValue& timeout, const QString& sessionId, CallFlags flags, LunaServiceManagerListener *listener)
 {
     if (QGuiApplication::arguments().contains(QStringLiteral("criu_enable")) &&
         m_appId.isEmpty()) {
@@ -157,8 +179,9 @@ int Service::callInternal(const QString& service, const QString& method, const Q
     auto token = m_serviceManager->call(service,
                                    method,
                                    payload,
-                                   this,
-                                   sessionId);
+                                   listener ? listener : this,
+                                   sessionId,
+                                   flags);
 
     if (token != LSMESSAGE_TOKEN_INVALID) {
         if (timeout.isNumber()) {
@@ -173,6 +196,22 @@ int Service::callInternal(const QString& service, const QString& method, const Q
     return token;
 }
 
+QJSValue Service::request(const QString& service, const QString& method, const QString& payload, const QJSValue& timeout)
+{
+    QJSEngine *engine = qjsEngine(this);
+    if (!engine) {
+        qWarning() << "request() is only available from QML, use call() instead" << service << method;
+        return QJSValue();
+    }
+
+    if (!m_requests)
+        m_requests = new PendingRequests(this);
+
+    QString effectiveSessionId(m_sessionId == "no-session" ? QString() : m_sessionId);
+    int token = callInternal(service, method, payload, timeout, effectiveSessionId, OneReplyCall, m_requests);
+    return m_requests->add(engine, token);
+}
+
 int Service::callForApplication(const QString& appId, const QString& service, const QString& method, const QString& payload, const QJSValue& timeout)
 {
     if (QGuiApplication::arguments().contains(QStringLiteral("criu_enable")) && m_appId.isEmpty()) {
@@ -206,15 +245,20 @@ int Service::callForApplication(const QString& appId, const QString& service, co
 
 int Service::callService(const QVariantMap& payload)
 {
-    return call(m_callServiceName, m_callServiceMethod, QJsonDocument::fromVariant(payload).toJson(QJsonDocument::Compact));
+    // Only a JSON true subscribes, as for the bus, not "true" or 1
+    const bool subscribe = QJsonValue::fromVariant(payload.value(strSubscribe)).toBool()
+            || QJsonValue::fromVariant(payload.value(strWatch)).toBool();
+    CallFlags flags = subscribe ? SubscriptionCall : OneReplyCall;
+    return callWithFlags(m_callServiceName, m_callServiceMethod,
+                         QJsonDocument::fromVariant(payload).toJson(QJsonDocument::Compact), flags);
 }
 
-int Service::callWithRetry(const QString& service, const QString& method, const QString & payload, int retry)
+int Service::callWithRetry(const QString& service, const QString& method, const QString & payload, int retry, CallFlags flags)
 {
     int i, token = LSMESSAGE_TOKEN_INVALID;
 
     for (i = 0; i < retry; i++) {
-        token = call(service, method, payload);
+        token = callWithFlags(service, method, payload, flags);
         if (token != LSMESSAGE_TOKEN_INVALID)
             return token;
 
@@ -230,37 +274,85 @@ int Service::callWithRetry(const QString& service, const QString& method, const
     return token;
 }
 
+int Service::callBatch(const QVariantList& calls)
+{
+    if (QGuiApplication::arguments().contains(QStringLiteral("criu_enable")) && m_appId.isEmpty()) {
+        qWarning() << "Disallow to register service status for empty appId on criu_enable";
+        return 0;
+    }
+
+    if (!m_serviceManager)
+        m_serviceManager = LunaServiceManager::instance(m_appId);
+
+    if (!m_serviceManager) return 0;
+
+    QVector<BatchCall> batchCalls;
+    batchCalls.reserve(calls.size());
+    for (const QVariant &item : calls) {
+        const QVariantMap map = item.toMap();
+        const QVariant payload = map.value(strPayload);
+
+        BatchCall call;
+        call.service = map.value(strService).toString();
+        call.method = map.value(strMethod).toString();
+        if (!payload.isValid())
+            call.payload = QLatin1String("{}");
+        else if (payload.type() == QVariant::String)
+            call.payload = payload.toString();
+        else
+            call.payload = QJsonDocument::fromVariant(payload).toJson(QJsonDocument::Compact);
+        if (map.contains(strTimeout))
+            call.timeout = map.value(strTimeout).toInt();
+        batchCalls.append(call);
+    }
+
+    QString effectiveSessionId(m_sessionId == "no-session" ? QString() : m_sessionId);
+    return m_serviceManager->callBatch(batchCalls, this, effectiveSessionId);
+}
+
 void Service::cancel(LSMessageToken token)
 {
     if (!m_serviceManager) return;
 
-    if (token == LSMESSAGE_TOKEN_INVALID)
+    if (token == LSMESSAGE_TOKEN_INVALID) {
         m_serviceManager->cancel(this);
-    else
+        if (m_requests) {
+            m_serviceManager->cancel(m_requests);
+            m_requests->rejectAll(QLatin1String("Request cancelled"));
+        }
+    } else if (m_requests && m_requests->contains(token)) {
+        m_serviceManager->cancel(m_requests, token);
+        m_requests->reject(token, QLatin1String("Request cancelled"));
+    } else {
         m_serviceManager->cancel(this, token);
+    }
 
     Q_EMIT cancelled(token);
 }
 
-void Service::serviceResponse(const QString& method, const QString& payload, int token)
+void Service::serviceResponse(const QString& method, const LunaServiceReply& reply, int token)
 {
-    checkForErrors(payload, token);
-    Q_EMIT response(method, payload, token);
+    static const QMetaMethod callSuccessSignal = QMetaMethod::fromSignal(&Service::callSuccess);
+    static const QMetaMethod callFailureSignal = QMetaMethod::fromSignal(&Service::callFailure);
+    static const QMetaMethod callResponseSignal = QMetaMethod::fromSignal(&Service::callResponse);
+    static const QMetaMethod callSuccessObjectSignal = QMetaMethod::fromSignal(&Service::callSuccessObject);
+    static const QMetaMethod callFailureObjectSignal = QMetaMethod::fromSignal(&Service::callFailureObject);
+    static const QMetaMethod callResponseObjectSignal = QMetaMethod::fromSignal(&Service::callResponseObject);
+
+    checkForErrors(reply, token);
+    emitResponse(method, reply, token);
 
     // NOTE:
     // It seems like a bug in Qt 5.9 where accessing "returnValue" key in obj
     // results in the key gets defined as "null". Due to this we have to keep
     // the original object untouched and use it when emitting signals.
-    QJsonParseError parseError;
-    parseError.error = QJsonParseError::NoError;
-
-    QJsonDocument doc = QJsonDocument::fromJson(payload.toUtf8(), &parseError);
-    if (parseError.error != QJsonParseError::NoError) {
+    if (!reply.isValid()) {
+        const QJsonParseError &parseError = reply.parseError();
         qWarning() << "JSON Parsing error:" << parseError.errorString();
         Q_EMIT error(-1, parseError.errorString(), token);
         return;
     }
-    QJsonObject obj = doc.object();
+    const QJsonObject &obj = reply.object();
 
     // Check if the JSON object is empty or invalid
     if (obj.isEmpty()) {
@@ -269,44 +361,206 @@ void Service::serviceResponse(const QString& method, const QString& payload, int
         return;
     }
 
-    QVariantMap vmap = obj.toVariantMap();
     // Check if the 'strReturnValue' key exists and is true
-    if (obj.contains(strReturnValue) && obj[strReturnValue].toBool())
-        Q_EMIT callSuccess(vmap);
-    else
-        Q_EMIT callFailure(vmap);
-    Q_EMIT callResponse(vmap);
+    const bool succeeded = obj.contains(strReturnValue) && obj[strReturnValue].toBool();
+    const bool notifyResult = isSignalConnected(succeeded ? callSuccessSignal : callFailureSignal);
+    const bool notifyResponse = isSignalConnected(callResponseSignal);
+    if (notifyResult || notifyResponse) {
+        const QVariantMap vmap = obj.toVariantMap();
+        if (notifyResult) {
+            if (succeeded)
+                Q_EMIT callSuccess(vmap);
+            else
+                Q_EMIT callFailure(vmap);
+        }
+        if (notifyResponse)
+            Q_EMIT callResponse(vmap);
+    }
+
+    // Straight into the engine, a new object per signal so that the
+    // handlers of one signal do not see the changes of another
+    QJSEngine *engine = qjsEngine(this);
+    if (!engine)
+        return;
+    if (isSignalConnected(succeeded ? callSuccessObjectSignal : callFailureObjectSignal)) {
+        if (succeeded)
+            Q_EMIT callSuccessObject(engine->toScriptValue(obj));
+        else
+            Q_EMIT callFailureObject(engine->toScriptValue(obj));
+    }
+    if (isSignalConnected(callResponseObjectSignal))
+        Q_EMIT callResponseObject(engine->toScriptValue(obj));
+}
+
+void Service::emitResponse(const QString& method, const LunaServiceReply& reply, int token)
+{
+    static const QMetaMethod responseSignal = QMetaMethod::fromSignal(&Service::response);
+
+    // The only consumer of the UTF-16 payload, build it for receivers only
+    if (isSignalConnected(responseSignal))
+        Q_EMIT response(method, reply.payload(), token);
 }
 
-void Service::hubError(const QString& method, const QString& error, const QString& payload, int token)
+void Service::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
 {
     qWarning() << "Hub error detected for token:" << token << method << error;
 
-    checkForErrors(payload, token);
+    checkForErrors(reply, token);
+}
+
+QJSValue PendingRequests::add(QJSEngine *engine, LSMessageToken token)
+{
+    if (engine != m_engine) {
+        m_engine = engine;
+        m_deferredFactory = engine->evaluate(QLatin1String(
+            "(function() {"
+            "    var deferred = {};"
+            "    deferred.promise = new Promise(function(resolve, reject) {"
+            "        deferred.resolve = resolve;"
+            "        deferred.reject = reject;"
+            "    });"
+            "    return deferred;"
+            "})"));
+    }
+
+    QJSValue deferred = m_deferredFactory.call();
+
+    Resolvers resolvers;
+    resolvers.resolve = deferred.property(QStringLiteral("resolve"));
+    resolvers.reject = deferred.property(QStringLiteral("reject"));
+
+    if (token == LSMESSAGE_TOKEN_INVALID)
+        resolvers.reject.call(QJSValueList() << m_engine->toScriptValue(errorObject(QLatin1String("Call could not be issued"))));
+    else
+        m_pending.insert((int) token, resolvers);
+
+    return deferred.property(QStringLiteral("promise"));
+}
+
+void PendingRequests::reject(LSMessageToken token, const QString& errorText)
+{
+    Resolvers resolvers = m_pending.take((int) token);
+    if (resolvers.reject.isCallable())
+        resolvers.reject.call(QJSValueList() << m_engine->toScriptValue(errorObject(errorText)));
+}
+
+void PendingRequests::rejectAll(const QString& errorText)
+{
+    const QHash<int, Resolvers> pending = m_pending;
+    m_pending.clear();
+
+    for (const Resolvers &resolvers : pending)
+        resolvers.reject.call(QJSValueList() << m_engine->toScriptValue(errorObject(errorText)));
+}
+
+void PendingRequests::serviceResponse(const QString& method, const LunaServiceReply& reply, int token)
+{
+    Q_UNUSED(method);
+    settle(token, reply.object());
+}
+
+void PendingRequests::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
+{
+    Q_UNUSED(method);
+
+    QJsonObject response = reply.object();
+    if (!response.contains(Service::strReturnValue)) {
+        response = errorObject(error);
+    }
+    settle(token, response);
+}
+
+void PendingRequests::settle(int token, const QJsonObject& response)
+{
+    Resolvers resolvers = m_pending.take(token);
+    if (!resolvers.resolve.isCallable())
+        return;
+
+    // The reply is already parsed, hand the object over as is
+    const QJSValue value = m_engine->toScriptValue(response);
+    if (response.value(Service::strReturnValue).toBool())
+        resolvers.resolve.call(QJSValueList() << value);
+    else
+        resolvers.reject.call(QJSValueList() << value);
+}
+
+QJsonObject PendingRequests::errorObject(const QString& errorText)
+{
+    const int errorCodeRequest = -1;
+
+    QJsonObject object;
+    object.insert(Service::strReturnValue, false);
+    object.insert(Service::strErrorCode, errorCodeRequest);
+    object.insert(Service::strErrorText, errorText);
+    return object;
+}
+
+void Service::batchResponse(int batchId, const QVector<BatchResult>& results)
+{
+    const int errorCodeNotIssued = -1;
+
+    QVariantList list;
+    list.reserve(results.size());
+    for (const BatchResult &result : results) {
+        QJsonObject response;
+        if (result.token == LSMESSAGE_TOKEN_INVALID) {
+            response.insert(strReturnValue, false);
+            response.insert(strErrorCode, errorCodeNotIssued);
+            response.insert(strErrorText, QLatin1String("Call could not be issued"));
+        } else {
+            response = result.reply.object();
+        }
+
+        QVariantMap item;
+        item.insert(strMethod, result.method);
+        item.insert(strToken, (int) result.token);
+        item.insert(strReturnValue, response.value(strReturnValue).toBool());
+        item.insert(strResponse, response.toVariantMap());
+        list.append(item);
+    }
+
+    Q_EMIT batchCompleted(batchId, list);
 }
 
 void Service::checkForErrors(const QJsonObject& rootObject, int token)
+{
+    checkForErrors(rootObject.value(strErrorCode), rootObject.value(strErrorText), token);
+}
+
+void Service::checkForErrors(const QJsonValue& errorCodeValue, const QJsonValue& errorTextValue, int token)
 {
     int errorCode = 0;
     QString errorText;
 
     //by API convention errorCode is missing instead being set to zero
-    if (!rootObject.contains(strErrorCode)) {
+    if (errorCodeValue.isUndefined()) {
         Q_EMIT success(token);
         return;
     }
 
-    errorCode = rootObject.value(strErrorCode).toInt();
-    errorText = rootObject.value(strErrorText).toString();
+    errorCode = errorCodeValue.toInt();
+    errorText = errorTextValue.toString();
 
     qWarning() << "Error response for token:" << token << errorCode << errorText;
 
     Q_EMIT error(errorCode, errorText, token);
 }
 
-void Service::checkForErrors(const QString& payload, int token)
+void Service::checkForErrors(const LunaServiceReply& reply, int token)
+{
+    checkForErrors(reply.object(), token);
+}
+
+QVector<QJsonValue> Service::extractValues(const LunaServiceReply& reply, const JsonPathExtractor& paths)
 {
-    checkForErrors(QJsonDocument::fromJson(payload.toUtf8()).object(), token);
+    if (reply.isParsed())
+        return paths.extract(reply.object());
+
+    bool ok = false;
+    QVector<QJsonValue> values = paths.extract(reply.payloadUtf8(), &ok);
+    if (!ok)
+        qWarning() << "JSON Parsing error while reading" << paths.size() << "values of a reply";
+    return values;
 }
 
 QString Service::interfaceName() const
@@ -329,7 +583,7 @@ int Service::registerServerStatus(const QString &serviceName, bool useSession)
     QString params = QJsonDocument(obj).toJson(QJsonDocument::Compact);
     int token = callInternal(QLatin1String("luna://com.webos.service.bus"),
                              QLatin1String("/signal/registerServerStatus"),
-                             params, QJSValue(), QString());
+                             params, QJSValue(), QString(), SubscriptionCall);
     if (token == LSMESSAGE_TOKEN_INVALID)
         qWarning() << "registerServerStatus failed, serviceName:" << serviceName << "appId:" << m_appId << "sessionId:" << m_sessionId << "useSession:" << useSession;
     else
@@ -361,6 +615,29 @@ void Service::setMethods(QStringList methods)
     emit methodsChanged();
 }
 
+/*!
+ * \brief Reruns a bus handler on the thread of the service
+ *
+ * With the bus thread enabled the LS2 handlers are invoked on that
+ * thread. The message is kept referenced until the handler has run
+ * on the thread the service lives in, or dropped with the service.
+ *
+ * \return false if already on the thread of the service
+ */
+static bool runOnServiceThread(LSFilterFunc handler, LSHandle *lshandle, LSMessage *msg, Service *s)
+{
+    if (QThread::currentThread() == s->thread())
+        return false;
+
+    LSMessageRef(msg);
+    std::shared_ptr<LSMessage> message(msg, LSMessageUnref);
+    QMetaObject::invokeMethod(s, [handler, lshandle, message, s]() {
+        handler(lshandle, message.get(), s);
+    }, Qt::QueuedConnection);
+
+    return true;
+}
+
 bool Service::callback(LSHandle *lshandle, LSMessage *msg, void *user_data)
 {
     Service* s = static_cast<Service *>(user_data);
@@ -370,8 +647,14 @@ bool Service::callback(LSHandle *lshandle, LSMessage *msg, void *user_data)
         return false;
     }
 
-    QString method(LSMessageGetMethod(msg));
-    QString payload(LSMessageGetPayload(msg));
+    if (runOnServiceThread(&Service::callback, lshandle, msg, s))
+        return true;
+
+    // Already UTF-8 and NUL-terminated, use it as is for lookups and subscriptions
+    const char *method = LSMessageGetMethod(msg);
+    // Read in place, the message outlives this call
+    const char *rawPayload = LSMessageGetPayload(msg);
+    const QByteArray payload = QByteArray::fromRawData(rawPayload, rawPayload ? qstrlen(rawPayload) : 0);
 #ifdef USE_LUNA_SERVICE2_SESSION_API
     QString sessionId(LSMessageGetSessionId(msg));
 #endif
@@ -390,7 +673,7 @@ bool Service::callback(LSHandle *lshandle, LSMessage *msg, void *user_data)
 
     QJsonObject returnObject;
     QJsonParseError jsonError;
-    QJsonDocument jsonDoc = QJsonDocument::fromJson(payload.toUtf8(), &jsonError);
+    QJsonDocument jsonDoc = QJsonDocument::fromJson(payload, &jsonError);
 
     if (jsonError.error != QJsonParseError::NoError) {
         returnObject.insert(strErrorCode, errorCodeJsonParse);
@@ -416,27 +699,43 @@ bool Service::callback(LSHandle *lshandle, LSMessage *msg, void *user_data)
         return success;
     }
 
-    QVariant returnedValue;
+    const MethodEntry *entry = s->resolveMethod(method);
+    QJsonObject retObj;
     bool retVal;
+
+    // Handlers may handle other requests in turn, e.g. through processEvents()
+    const ActiveRequest outer = s->m_activeRequest;
+    s->m_activeRequest = ActiveRequest();
+    s->m_activeRequest.handle = lshandle;
+    s->m_activeRequest.message = msg;
+    if (LSMessageIsSubscription(msg))
+        s->m_activeRequest.subscriptionKey = s->subscriptionKey(method, message);
+    const QByteArray activeKey = s->m_activeRequest.subscriptionKey;
+
     if (s->needToKnowCaller()) {
         QJsonObject param;
         param.insert(strPayload, message);
         param.insert(strCallerId, callerId);
-        retVal = QMetaObject::invokeMethod(const_cast<Service*>(s), method.toUtf8().constData(),
-                                                Q_RETURN_ARG(QVariant, returnedValue),
-                                                Q_ARG(QVariant, QVariant::fromValue(param)));
+        retVal = s->invokeMethodEntry(entry, param, &retObj);
     } else {
-        retVal = QMetaObject::invokeMethod(const_cast<Service*>(s), method.toUtf8().constData(),
-                                                Q_RETURN_ARG(QVariant, returnedValue),
-                                                Q_ARG(QVariant, QVariant::fromValue(message)));
+        retVal = s->invokeMethodEntry(entry, message, &retObj);
     }
 
-    QJsonObject retObj = QJsonDocument::fromJson(returnedValue.toString().toUtf8()).object();
-    if (!retObj.contains(strErrorCode)) {
-        success = true;
-    } else {
-        success = false;
-    }
+    const bool deferred = s->m_activeRequest.deferred != nullptr;
+    s->m_activeRequest = outer;
+
+    // Answered later through the DeferredReply
+    if (deferred)
+        return retVal;
+
+    sendReply(lshandle, msg, retObj, s, activeKey);
+    return retVal;
+}
+
+bool Service::sendReply(LSHandle *lshandle, LSMessage *msg, QJsonObject retObj, Service *s, const QByteArray& subscriptionKey)
+{
+    const bool success = !retObj.contains(strErrorCode);
+    QJsonObject returnObject;
 
     bool subscribed = false;
     if (!success) {
@@ -446,26 +745,40 @@ bool Service::callback(LSHandle *lshandle, LSMessage *msg, void *user_data)
         if (!retObj[strErrorMsg].isNull())
             returnObject.insert(strErrorMsg, retObj[strErrorMsg]);
     } else {
-        QStringList keys = retObj.keys();
-        QString key;
-        for(int ind = 0; ind < keys.length(); ind++) {
-            key = keys.at(ind);
-            returnObject.insert(key, retObj[key]);
-        }
         LSErrorSafe lserror;
-        if (LSMessageIsSubscription(msg)) {
-            subscribed = LSSubscriptionAdd(lshandle, method.toUtf8().constData(), msg, &lserror);
-            returnObject.insert(strSubscribed, subscribed);
-            if (subscribed)
+        if (LSMessageIsSubscription(msg) && s) {
+            const char *key = subscriptionKey.isEmpty() ? LSMessageGetMethod(msg) : subscriptionKey.constData();
+            subscribed = LSSubscriptionAdd(lshandle, key, msg, &lserror);
+            retObj.insert(strSubscribed, subscribed);
+            if (subscribed) {
                 LSSubscriptionSetCancelFunction(lshandle, &Service::callbackSubscriptionCancel, (void*)s, &lserror);
+                if (!subscriptionKey.isEmpty())
+                    s->m_subscribedKeys[QString::fromUtf8(LSMessageGetMethod(msg))].insert(subscriptionKey);
+            }
         }
     }
-    returnObject.insert(strReturnValue, success);
-    QJsonDocument doc(returnObject);
+
+    // The reply of the handler is completed in place and serialized once
+    QJsonObject &reply = success ? retObj : returnObject;
+    reply.insert(strReturnValue, success);
 
     LSErrorSafe lsError;
-    success = LSMessageReply(lshandle, msg, doc.toJson().data(), &lsError);
-    return retVal;
+    return LSMessageReply(lshandle, msg, QJsonDocument(reply).toJson(QJsonDocument::Compact).constData(), &lsError);
+}
+
+DeferredReply *Service::defer()
+{
+    if (!m_activeRequest.message) {
+        qWarning() << "defer() is only available from within a method handler of" << appId();
+        return nullptr;
+    }
+
+    if (!m_activeRequest.deferred) {
+        m_activeRequest.deferred = new DeferredReply(this, m_activeRequest.handle, m_activeRequest.message,
+                                                     m_activeRequest.subscriptionKey);
+        QQmlEngine::setObjectOwnership(m_activeRequest.deferred, QQmlEngine::CppOwnership);
+    }
+    return m_activeRequest.deferred;
 }
 
 bool Service::callbackSubscriptionCancel(LSHandle *lshandle, LSMessage *msg, void *user_data)
@@ -477,6 +790,9 @@ bool Service::callbackSubscriptionCancel(LSHandle *lshandle, LSMessage *msg, voi
         return false;
     }
 
+    if (runOnServiceThread(&Service::callbackSubscriptionCancel, lshandle, msg, s))
+        return true;
+
     QString method(LSMessageGetMethod(msg));
 
     Q_EMIT s->subscriptionAboutToCancel(method);
@@ -485,6 +801,35 @@ bool Service::callbackSubscriptionCancel(LSHandle *lshandle, LSMessage *msg, voi
 }
 
 void Service::pushSubscription(const QString& method, const QString& param, const QString& responseMethod)
+{
+    if (!m_pushCoalescedMethods.contains(method)) {
+        pushSubscriptionNow(method, param, responseMethod);
+        return;
+    }
+
+    // The latest push of the method wins, sent once the current event is handled
+    if (!m_pendingPushes.contains(method))
+        m_pendingPushOrder.append(method);
+    m_pendingPushes.insert(method, qMakePair(param, responseMethod));
+
+    if (m_pendingPushOrder.size() == 1)
+        QMetaObject::invokeMethod(this, [this]() { flushPushes(); }, Qt::QueuedConnection);
+}
+
+void Service::flushPushes()
+{
+    const QStringList order = m_pendingPushOrder;
+    const QHash<QString, QPair<QString, QString>> pushes = m_pendingPushes;
+    m_pendingPushOrder.clear();
+    m_pendingPushes.clear();
+
+    for (const QString &method : order) {
+        const QPair<QString, QString> &push = pushes[method];
+        pushSubscriptionNow(method, push.first, push.second);
+    }
+}
+
+void Service::pushSubscriptionNow(const QString& method, const QString& param, const QString& responseMethod)
 {
     if (!m_serviceManager)
         m_serviceManager = LunaServiceManager::instance(m_appId);
@@ -507,28 +852,24 @@ void Service::pushSubscription(const QString& method, const QString& param, cons
         return;
     }
 
+    // Nobody to push to, the producer need not run
+    const QVector<QByteArray> targets = subscriptionTargets(serviceHandle, method);
+    if (targets.isEmpty())
+        return;
+
     // Use method if responseMethod is not set
     QString member = responseMethod.isEmpty() ? method : responseMethod;
     QJsonObject arg = QJsonDocument::fromJson(param.length() == 0 ? "{}" : param.toUtf8()).object();
-    QVariant returnedValue;
+    QJsonObject retObj;
 
-    if (QMetaObject::invokeMethod(this,
-                member.toUtf8().constData(),
-                Q_RETURN_ARG(QVariant, returnedValue),
-                Q_ARG(QVariant, QVariant::fromValue(arg)))) {
-        QJsonObject retObj = QJsonDocument::fromJson(returnedValue.toString().toUtf8()).object();
-        QJsonObject returnObject;
+    if (invokeMethodEntry(resolveMethod(InternTable::string(member).constData()), arg, &retObj)) {
         if (!retObj.contains(strErrorCode)) {
-            QStringList keys = retObj.keys();
-            QString key;
-            for(int ind = 0; ind < keys.length(); ind++) {
-                key = keys.at(ind);
-                returnObject.insert(key, retObj[key]);
+            retObj.insert(strReturnValue, true);
+            const QByteArray reply = QJsonDocument(retObj).toJson(QJsonDocument::Compact);
+            for (const QByteArray &target : targets) {
+                LSErrorSafe lserror;
+                LSSubscriptionReply(serviceHandle, target.constData(), reply.constData(), &lserror);
             }
-            returnObject.insert(strReturnValue, true);
-            LSErrorSafe lserror;
-            QJsonDocument doc(returnObject);
-            LSSubscriptionReply(serviceHandle, method.toUtf8().constData(), doc.toJson().data(), &lserror);
         } else {
             qWarning() << "Nothing to push for method " << method << "for service" << appId();
         }
@@ -537,16 +878,111 @@ void Service::pushSubscription(const QString& method, const QString& param, cons
     }
 }
 
+QByteArray Service::keyedName(const QString& method, const QString& key)
+{
+    // Not interned: the keys come from the payloads. LS2 copies the key.
+    return (method + QLatin1Char('/') + key).toUtf8();
+}
+
+QByteArray Service::subscriptionKey(const char *method, const QJsonObject& message) const
+{
+    if (m_subscriptionKeys.isEmpty())
+        return QByteArray();
+
+    const QString field = m_subscriptionKeys.value(QString::fromUtf8(method)).toString();
+    if (field.isEmpty())
+        return QByteArray();
+
+    // Without the field the request gets the pushes of every key
+    const QJsonValue value = message.value(field);
+    if (!value.isString() && !value.isDouble())
+        return QByteArray();
+
+    return keyedName(QString::fromUtf8(method), value.toVariant().toString());
+}
+
+void Service::pushSubscriptionKeyed(const QString& method, const QString& key, const QJSValue& payload)
+{
+    if (!m_serviceManager)
+        m_serviceManager = LunaServiceManager::instance(m_appId);
+
+    LSHandle *serviceHandle = m_serviceManager ? m_serviceManager->getServiceHandle() : nullptr;
+    if (!serviceHandle) {
+        qWarning() << "Failed at pushSubscriptionKeyed for method" << method << "due to invalid handle";
+        return;
+    }
+
+    if (!m_methods.contains(method)) {
+        qWarning() << "No method " << method << "for service" << appId();
+        return;
+    }
+
+    // The subscribers of the key and those of every key, skipped if idle
+    const QByteArray keys[] = { keyedName(method, key), InternTable::string(method) };
+    QByteArray reply;
+    for (const QByteArray &target : keys) {
+        if (LSSubscriptionGetHandleSubscribersCount(serviceHandle, target.constData()) == 0)
+            continue;
+
+        if (reply.isEmpty()) {
+            QJsonObject retObj = replyObject(QVariant::fromValue(payload));
+            if (retObj.contains(strErrorCode)) {
+                qWarning() << "Nothing to push for method " << method << "key" << key << "for service" << appId();
+                return;
+            }
+            retObj.insert(strReturnValue, true);
+            reply = QJsonDocument(retObj).toJson(QJsonDocument::Compact);
+        }
+
+        LSErrorSafe lserror;
+        LSSubscriptionReply(serviceHandle, target.constData(), reply.constData(), &lserror);
+    }
+}
+
 unsigned int Service::subscribersCount(const QString& method)
 {
-    LSHandle *serviceHandle = m_serviceManager->getServiceHandle();
+    LSHandle *serviceHandle = m_serviceManager ? m_serviceManager->getServiceHandle() : nullptr;
 
     if (!serviceHandle) {
         qWarning() << "Failed at subscribersCount for method" << method << "due to invalid handle";
         return 0;
     }
 
-    return LSSubscriptionGetHandleSubscribersCount(m_serviceManager->getServiceHandle(), method.toUtf8().constData());
+    unsigned int count = 0;
+    subscriptionTargets(serviceHandle, method, &count);
+    return count;
+}
+
+QVector<QByteArray> Service::subscriptionTargets(LSHandle *serviceHandle, const QString& method, unsigned int *count)
+{
+    QVector<QByteArray> targets;
+    unsigned int total = 0;
+
+    const QByteArray methodName = InternTable::string(method);
+    if (const unsigned int subscribers = LSSubscriptionGetHandleSubscribersCount(serviceHandle, methodName.constData())) {
+        targets.append(methodName);
+        total += subscribers;
+    }
+
+    QHash<QString, QSet<QByteArray>>::iterator keys = m_subscribedKeys.find(method);
+    if (keys != m_subscribedKeys.end()) {
+        for (QSet<QByteArray>::iterator it = keys->begin(); it != keys->end();) {
+            const unsigned int subscribers = LSSubscriptionGetHandleSubscribersCount(serviceHandle, it->constData());
+            if (!subscribers) {
+                it = keys->erase(it);
+                continue;
+            }
+            targets.append(*it);
+            total += subscribers;
+            ++it;
+        }
+        if (keys->isEmpty())
+            m_subscribedKeys.erase(keys);
+    }
+
+    if (count)
+        *count = total;
+    return targets;
 }
 
 void Service::registerMethods(const QStringList &methods)
@@ -574,7 +1010,13 @@ void Service::registerMethods(const QStringList &methods)
     }
 
     for (const auto &method : methods) {
-        auto methodName = method.toUtf8();
+        const QByteArray methodName = InternTable::string(method);
+
+        // Resolved here once rather than by name on every request
+        MethodEntry &entry = m_dispatch[methodName];
+        entry.name = methodName;
+        if (!entry.native)
+            entry.meta = metaObject()->method(metaObject()->indexOfMethod((methodName + "(QVariant)").constData()));
 
         LSMethod methodMap[] = {
             {methodName.constData(), &Service::callback, LUNA_METHOD_FLAGS_NONE},
@@ -594,6 +1036,75 @@ void Service::registerMethods(const QStringList &methods)
     }
 }
 
+void Service::setNativeMethod(const QString& method, const NativeMethod& handler)
+{
+    const QByteArray methodName = InternTable::string(method);
+
+    MethodEntry &entry = m_dispatch[methodName];
+    entry.name = methodName;
+    entry.native = handler;
+}
+
+const Service::MethodEntry *Service::resolveMethod(const char *method)
+{
+    QHash<QByteArray, MethodEntry>::iterator it = m_dispatch.find(QByteArray::fromRawData(method, qstrlen(method)));
+    if (it == m_dispatch.end()) {
+        // Not a bus method, e.g. the responseMethod of pushSubscription()
+        const QByteArray methodName = InternTable::string(QString::fromUtf8(method));
+        it = m_dispatch.insert(methodName, MethodEntry());
+        it->name = methodName;
+    }
+
+    // The function may not have been there when the methods were registered
+    if (!it->native && !it->meta.isValid())
+        it->meta = metaObject()->method(metaObject()->indexOfMethod((it->name + "(QVariant)").constData()));
+
+    return &it.value();
+}
+
+bool Service::invokeMethodEntry(const MethodEntry *entry, const QJsonObject& argument, QJsonObject *result)
+{
+    if (entry->native) {
+        *result = entry->native(argument);
+        return true;
+    }
+
+    QVariant returnedValue;
+    if (!entry->meta.isValid()
+            || !entry->meta.invoke(this, Qt::DirectConnection,
+                                  Q_RETURN_ARG(QVariant, returnedValue),
+                                  Q_ARG(QVariant, QVariant::fromValue(argument)))) {
+        *result = QJsonObject();
+        return false;
+    }
+
+    *result = replyObject(returnedValue);
+    return true;
+}
+
+QJsonObject Service::replyObject(const QVariant& returnedValue)
+{
+    const int type = returnedValue.userType();
+
+    // An object returned by a QML function, taken over without a round trip through JSON text
+    if (type == qMetaTypeId<QJSValue>()) {
+        const QJSValue value = returnedValue.value<QJSValue>();
+        if (value.isString())
+            return QJsonDocument::fromJson(value.toString().toUtf8()).object();
+        QJSEngine *engine = qjsEngine(this);
+        if (engine && value.isObject() && !value.isArray())
+            return engine->fromScriptValue<QJsonObject>(value);
+        return QJsonValue::fromVariant(value.toVariant()).toObject();
+    }
+    if (type == QMetaType::QJsonObject)
+        return returnedValue.toJsonObject();
+    if (type == QMetaType::QVariantMap)
+        return QJsonObject::fromVariantMap(returnedValue.toMap());
+
+    // A JSON string, as the handlers always returned
+    return QJsonDocument::fromJson(returnedValue.toString().toUtf8()).object();
+}
+
 void Service::setCategory(const QString& category)
 {
     Q_ASSERT(m_category.length() == 0);
@@ -618,129 +1129,84 @@ void Service::setNeedToKnowCaller(bool enable)
     emit needToKnowCallerChanged();
 }
 
-void Service::setCallServiceName(QString& newServiceName) {
-    if (!newServiceName.startsWith(strURISchemeDeprecated) && !newServiceName.startsWith(strURIScheme)) {
-        newServiceName.prepend(strURIScheme);
-    }
-    if (!newServiceName.endsWith(QChar('/'))) {
-        newServiceName.append(QChar('/'));
-    }
-    m_callServiceName = newServiceName;
+ReplyCoalescer *Service::coalescer()
+{
+    if (!m_coalescer)
+        m_coalescer = new ReplyCoalescer(this);
+    return m_coalescer;
 }
 
-static QSharedPointer<MessageSpreader> s_messageSpreader;
-
-MessageSpreader *MessageSpreader::instance()
+QStringList Service::coalescedMethods() const
 {
-    if (!s_messageSpreader.get())
-        s_messageSpreader.reset(new MessageSpreader());
-    return s_messageSpreader.get();
+    return m_coalescer ? m_coalescer->methods() : QStringList();
 }
 
-MessageSpreader::MessageSpreader()
+void Service::setCoalescedMethods(const QStringList& methods)
 {
-    m_postSleepMs = qgetenv("WEBOS_QML_WEBOSSERVICES_SPREAD_EVENTS_WAIT_AFTER_RESPONSE").toUInt();
+    if (methods == coalescedMethods())
+        return;
+    coalescer()->setMethods(methods);
+    emit coalescedMethodsChanged();
 }
 
-MessageSpreader::~MessageSpreader()
+int Service::coalesceInterval() const
 {
-    QThread::wait();
+    return m_coalescer ? m_coalescer->interval() : 0;
 }
 
-void MessageSpreader::removeListener(MessageSpreaderListener *listener)
+void Service::setCoalesceInterval(int interval)
 {
-    QMutexLocker locker(&m_mutex);
-    m_listeners.remove(listener->m_handle);
-    messageRespondedInternal(listener);
+    if (interval == coalesceInterval())
+        return;
+    coalescer()->setInterval(interval);
+    emit coalesceIntervalChanged();
 }
 
-void MessageSpreader::messageResponded(MessageSpreaderListener *listener)
+QString Service::coalesceKey() const
 {
-    QMutexLocker locker(&m_mutex);
-    messageRespondedInternal(listener);
+    return m_coalescer ? m_coalescer->key() : QString();
 }
 
-void MessageSpreader::messageRespondedInternal(MessageSpreaderListener *listener)
+void Service::setCoalesceKey(const QString& key)
 {
-    if (listener->m_emitted) {
-        listener->m_emitted = false;
-        m_semaphore.release();
-    }
+    if (key == coalesceKey())
+        return;
+    coalescer()->setKey(key);
+    emit coalesceKeyChanged();
 }
 
-void MessageSpreader::pushMessageResponse(MessageSpreaderListener *listener, const QString& method, const QString& payload, int token)
+bool Service::coalesceReply(const QString& method, const LunaServiceReply& reply, int token, const char *uri)
 {
-    Response response;
-    response.method = method;
-    response.listenerHandle = listener->m_handle;
-    response.payload = payload;
-    response.token = token;
-    response.listener = listener;
-
-    QMutexLocker locker(&m_mutex);
-    m_responses.enqueue(response);
-    m_listeners.insert(response.listenerHandle);
-
-    QThread::start();
+    return m_coalescer && m_coalescer->add(method, reply, token, uri);
 }
 
-void MessageSpreader::run()
-{
-    Response response;
-    while (true) {
-        bool emitted = false;
-        {
-            QMutexLocker locker(&m_mutex);
-            if (m_responses.empty())
-                return;
-            response = m_responses.dequeue();
-            if (m_listeners.contains(response.listenerHandle)) {
-                response.listener->m_emitted = emitted = true;
-                const QJsonObject &jsonPayload = QJsonDocument::fromJson(response.payload.toUtf8()).object();
-                emit response.listener->serviceResponseSignal(response.method, response.payload, response.token, jsonPayload);
-            }
-        }
-        if (emitted) {
-            m_semaphore.acquire();
-            QThread::msleep(m_postSleepMs);
-        }
+void Service::setCallServiceName(QString& newServiceName) {
+    if (!newServiceName.startsWith(strURISchemeDeprecated) && !newServiceName.startsWith(strURIScheme)) {
+        newServiceName.prepend(strURIScheme);
     }
+    if (!newServiceName.endsWith(QChar('/'))) {
+        newServiceName.append(QChar('/'));
+    }
+    m_callServiceName = newServiceName;
 }
 
 MessageSpreaderListener::MessageSpreaderListener(QObject *parent)
     :Service(parent)
 {
-    static size_t s_handle = 0;
-    if (s_handle == UINT_MAX) {
-        qWarning() << "Cannot increase s_handle greater than " << UINT_MAX;
-        s_handle = 0;
-    }
-    m_handle = ++s_handle;
-
     m_spreadMethods = QString(qgetenv("WEBOS_QML_WEBOSSERVICES_SPREAD_METHODS")).split(',');
-
-    connect(this, &MessageSpreaderListener::serviceResponseSignal,
-            this, &MessageSpreaderListener::serviceResponseSlot);
 }
 
 MessageSpreaderListener::~MessageSpreaderListener()
 {
-    MessageSpreader::instance()->removeListener(this);
 }
 
-void MessageSpreaderListener::serviceResponse(const QString& method, const QString& payload, int token)
+bool MessageSpreaderListener::offloadReplies(const QString& method) const
 {
-    if (m_spreadEvents && m_spreadMethods.contains(method)) {
-        // TODO: Consider spread response automatically when service reply with heavy payload(payload.size() is greater than some threshold)
-        MessageSpreader::instance()->pushMessageResponse(this, method, payload, token);
-    } else {
-        const QJsonObject &jsonPayload = QJsonDocument::fromJson(payload.toUtf8()).object();
-        serviceResponseDelayed(method, payload, token, jsonPayload);
-    }
+    return m_spreadEvents && m_spreadMethods.contains(method);
 }
 
-void MessageSpreaderListener::serviceResponseSlot(const QString& method, const QString& payload, int token, const QJsonObject &jsonPayload)
+void MessageSpreaderListener::serviceResponse(const QString& method, const LunaServiceReply& reply, int token)
 {
-    serviceResponseDelayed(method, payload, token, jsonPayload);
-    MessageSpreader::instance()->messageResponded(this);
+    // Heavy replies come parsed from the DecodePool, see dispatchReply()
+    serviceResponseDelayed(method, reply, token);
 }
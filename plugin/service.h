@@ -17,16 +17,27 @@
 #ifndef SERVICE_H
 #define SERVICE_H
 
+#include <functional>
+
 #include <QObject>
 #include <QStringList>
 #include <QDebug>
 #include <QHash>
 #include <QJSValue>
 #include <QJsonObject>
+#include <QMetaMethod>
+#include <QPair>
 #include <QPointer>
+#include <QSet>
 #include <QVariant>
+#include <QVector>
 
 #include "lunaservicemgr.h"
+#include "jsonpathextractor.h"
+
+class PendingRequests;
+class DeferredReply;
+class ReplyCoalescer;
 
 /*!
  * \class Service
@@ -44,6 +55,8 @@
  *        function myMethod(msg) {
  *            // The msg is a JSON object that contains all the data
  *            // that the caller provided
+ *            // The reply is an object or, as before, a JSON string
+ *            return { "result": msg.value };
  *        }
  *    }
  *
@@ -74,16 +87,73 @@ class Service : public LunaServiceManagerListener
 
     Q_PROPERTY(bool needToKnowCaller MEMBER m_needToKnowCaller WRITE setNeedToKnowCaller READ needToKnowCaller NOTIFY needToKnowCallerChanged)
 
+    /*!
+     * \brief Methods whose subscription replies are coalesced, e.g.
+     * ["/getAppLifeEvents"]: of the replies that come within
+     * coalesceInterval only the latest one per coalesceKey is delivered.
+     * One-reply calls are never coalesced.
+     */
+    Q_PROPERTY(QStringList coalescedMethods READ coalescedMethods WRITE setCoalescedMethods NOTIFY coalescedMethodsChanged)
+
+    /*!
+     * \brief Interval of coalescedMethods in ms, 0 (default) for one
+     * frame of the primary screen
+     */
+    Q_PROPERTY(int coalesceInterval READ coalesceInterval WRITE setCoalesceInterval NOTIFY coalesceIntervalChanged)
+
+    /*!
+     * \brief Top-level field of the reply, e.g. "appId", whose values are
+     * coalesced apart. Empty (default) for the latest reply only.
+     */
+    Q_PROPERTY(QString coalesceKey READ coalesceKey WRITE setCoalesceKey NOTIFY coalesceKeyChanged)
+
+    /*!
+     * \brief Methods whose pushSubscription() calls within one event loop
+     * iteration are sent once, with the latest parameters
+     */
+    Q_PROPERTY(QStringList pushCoalescedMethods MEMBER m_pushCoalescedMethods NOTIFY pushCoalescedMethodsChanged)
+
+    /*!
+     * \brief Payload field per method that subscriptions are partitioned
+     * by, e.g. {"getAppState": "appId"}
+     *
+     * A subscription request with the field is added under the key
+     * "method/value" and only gets the pushes of pushSubscriptionKeyed()
+     * for that value, along with those of pushSubscription() that go to
+     * every subscriber. A request without it gets all the pushes.
+     */
+    Q_PROPERTY(QVariantMap subscriptionKeys MEMBER m_subscriptionKeys NOTIFY subscriptionKeysChanged)
+
 public:
     Service (QObject * parent = 0);
     virtual ~Service();
 
+    /*!
+     * \brief Handler of a bus method implemented in C++. It gets the
+     * payload of the request, or the payload and the callerId if
+     * needToKnowCaller is set, and returns the reply, with errorCode
+     * and errorText set for an error.
+     */
+    typedef std::function<QJsonObject(const QJsonObject& message)> NativeMethod;
+
+    /*!
+     * \brief Handles method with handler instead of the function of the
+     * same name. The method still has to be listed in methods.
+     */
+    void setNativeMethod(const QString& method, const NativeMethod& handler);
+
     void setCallServiceName(QString& newServiceName);
     QString callServiceName() { return m_callServiceName; }
     void setCallMethodName(QString& newMethodName) { m_callServiceMethod = newMethodName; }
     QString callMethodName() { return m_callServiceMethod; }
     void setNeedToKnowCaller(bool enable);
     bool needToKnowCaller() { return m_needToKnowCaller; }
+    QStringList coalescedMethods() const;
+    void setCoalescedMethods(const QStringList& methods);
+    int coalesceInterval() const;
+    void setCoalesceInterval(int interval);
+    QString coalesceKey() const;
+    void setCoalesceKey(const QString& key);
 
     /*!
      * \brief The most basic service request associated with a certain
@@ -107,12 +177,36 @@ public:
                           const QJSValue& timeout = QJSValue(),
                           const QString& sessionId = QLatin1String(""));
 
+    /*!
+     * \brief Same as call() but returns a Promise instead of a token.
+     *
+     * The Promise is resolved with the reply object if it has
+     * "returnValue": true and rejected with it otherwise. It is also
+     * rejected if the call can't be issued or is cancelled. The reply
+     * doesn't go through the response signals. Always a one-reply call.
+     */
+    Q_INVOKABLE QJSValue request(const QString& service,
+                                 const QString& method,
+                                 const QString& payload = QLatin1String("{}"),
+                                 const QJSValue& timeout = QJSValue());
+
     Q_INVOKABLE int callForApplication( const QString& appId,
                                         const QString& service,
                                         const QString& method,
                                         const QString& payload = QLatin1String("{}"),
                                         const QJSValue& timeout = QJSValue());
 
+    /*!
+     * \brief Same as call() but with the kind of call given explicitly,
+     * so the payload doesn't have to be scanned for "subscribe"/"watch".
+     */
+    int callWithFlags(const QString& service,
+                      const QString& method,
+                      const QString& payload,
+                      CallFlags flags,
+                      const QJSValue& timeout = QJSValue(),
+                      const QString& sessionId = QLatin1String(""));
+
     /*!
      * \brief Call to service bus using service and method properties.
      * \param payload The Javascript object to use as the method call parameters.
@@ -120,7 +214,18 @@ public:
      */
     Q_INVOKABLE int callService(const QVariantMap& payload);
 
-    int callWithRetry(const QString& service, const QString& method, const QString & payload, int retry = 5);
+    int callWithRetry(const QString& service, const QString& method, const QString & payload, int retry = 5, CallFlags flags = AutoDetectCall);
+
+    /*!
+     * \brief Issues several calls at once and reports them together.
+     *
+     * Each item is an object with "service", "method", an optional
+     * "payload" given as a string or as an object and an optional
+     * "timeout". Every call is a one-reply call. No per-call signal is
+     * emitted for these calls; batchCompleted() is emitted once instead.
+     * \return The id of the batch, 0 for error condition.
+     */
+    Q_INVOKABLE int callBatch(const QVariantList& calls);
 
     /*!
      * \brief Terminates a call causing any subscription for
@@ -129,12 +234,20 @@ public:
     Q_INVOKABLE void cancel(LSMessageToken token = LSMESSAGE_TOKEN_INVALID);
 
     /*!
-     * Push data to subscribers
+     * Push data to subscribers, the keyed ones included. The method
+     * producing the data is not called if the method has no subscribers.
      */
     Q_INVOKABLE void pushSubscription(const QString& method, const QString& param = QString(""), const QString& responseMethod = QString(""));
 
     /*!
-     * Count of current subscribers
+     * \brief Pushes payload, an object or a JSON string, to the
+     * subscribers of method under key and to those of the whole method
+     * \see subscriptionKeys
+     */
+    Q_INVOKABLE void pushSubscriptionKeyed(const QString& method, const QString& key, const QJSValue& payload);
+
+    /*!
+     * Count of current subscribers, the keyed ones included
      */
     Q_INVOKABLE unsigned int subscribersCount(const QString &method);
 
@@ -146,6 +259,16 @@ public:
      */
     Q_INVOKABLE int registerServerStatus(const QString &serviceName, bool useSession = false);
 
+    /*!
+     * \brief Defers the reply to the request being handled
+     *
+     * Only valid from within a method handler. The return value of the
+     * handler is then ignored and the reply is sent through the returned
+     * DeferredReply, once it is known.
+     * \return nullptr if no request is being handled
+     */
+    Q_INVOKABLE DeferredReply *defer();
+
     /*!
      * \brief Derived classes reimplement the matching interface name
      * \return The name that identifies this service on the bus
@@ -166,6 +289,7 @@ public:
     static const QLatin1String strURISchemeDeprecated;
     static const QLatin1String strReturnValue;
     static const QLatin1String strSubscribe;
+    static const QLatin1String strWatch;
     static const QLatin1String strSubscribed;
     static const QLatin1String strErrorCode;
     static const QLatin1String strErrorText;
@@ -284,6 +408,32 @@ Q_SIGNALS:
      */
     void callResponse(QVariantMap response);
 
+    /*!
+     * \brief Same as callSuccess(), with the response converted straight
+     * into a Javascript object rather than through a QVariantMap. Only
+     * emitted for a Service owned by a QML engine.
+     */
+    void callSuccessObject(const QJSValue& response);
+
+    /*!
+     * \brief Same as callFailure(), see callSuccessObject()
+     */
+    void callFailureObject(const QJSValue& response);
+
+    /*!
+     * \brief Same as callResponse(), see callSuccessObject()
+     */
+    void callResponseObject(const QJSValue& response);
+
+    /*!
+     * \brief Emitted once all the calls of a batch are answered.
+     * \param batchId The id returned by callBatch()
+     * \param results One object per call, in the order of the calls, with
+     *        "method", "token", "returnValue" and "response", the
+     *        Javascript object of the reply
+     */
+    void batchCompleted(int batchId, const QVariantList& results);
+
     /*!
      * \brief Indicates that the call has been cancelled.
      * \param token Provides the token that is cancelled.
@@ -305,6 +455,11 @@ Q_SIGNALS:
     void needToKnowCallerChanged();
     void callServiceChanged();
     void callMethodChanged();
+    void coalescedMethodsChanged();
+    void coalesceIntervalChanged();
+    void coalesceKeyChanged();
+    void pushCoalescedMethodsChanged();
+    void subscriptionKeysChanged();
 
 protected:
 
@@ -312,22 +467,45 @@ protected:
      * \brief Is used to process the reply from the bus. Emits the response signal.
      * \param method The method of the service that has been called
               (e.g. "/getPreferences")
-     * \param payload The raw JSON reply from the bus
+     * \param reply The reply from the bus, parsed once and shared
      * \param token Provides the caller's token that is answered by this reply
      */
-    virtual void serviceResponse( const QString& method, const QString& payload, int token );
+    virtual void serviceResponse( const QString& method, const LunaServiceReply& reply, int token );
+
+    virtual void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token);
 
-    virtual void hubError(const QString& method, const QString& error, const QString& payload, int token);
+    void batchResponse(int batchId, const QVector<BatchResult>& results) override;
+
+    bool coalesceReply(const QString& method, const LunaServiceReply& reply, int token, const char *uri) override;
 
     /*!
-     * \brief Checks for errors in the given payload and emits the
+     * \brief Checks for errors in the given reply and emits the
      *        success() and error() Qt signals.
-     * \param payload the raw JSON reply from the bus
+     * \param reply the reply from the bus
      * \param token provides the caller's token that is answered by this reply
      */
-    void checkForErrors( const QString& payload, int token );
+    void checkForErrors( const LunaServiceReply& reply, int token );
     void checkForErrors( const QJsonObject& json, int token );
 
+    /*!
+     * \brief Same as above with the errorCode and errorText members
+     * only, undefined if missing
+     */
+    void checkForErrors( const QJsonValue& errorCode, const QJsonValue& errorText, int token );
+
+    /*!
+     * \brief Reads the values of a few paths out of a reply, from the
+     * parsed object if there is one and from the payload bytes otherwise,
+     * so a reply that is not parsed yet stays unparsed
+     * \see JsonPathExtractor
+     */
+    static QVector<QJsonValue> extractValues(const LunaServiceReply& reply, const JsonPathExtractor& paths);
+
+    /*!
+     * \brief Emits the response signal if anything is connected to it
+     */
+    void emitResponse(const QString& method, const LunaServiceReply& reply, int token);
+
 private:
     LunaServiceManager* m_serviceManager;
     QString m_appId;
@@ -343,12 +521,86 @@ private:
 
     bool m_needToKnowCaller = false;
 
+    PendingRequests *m_requests = nullptr;
+
+    /*!
+     * \brief The request whose handler is running, see defer()
+     */
+    struct ActiveRequest
+    {
+        LSHandle *handle = nullptr;
+        LSMessage *message = nullptr;
+        DeferredReply *deferred = nullptr;
+        QByteArray subscriptionKey;
+    };
+    ActiveRequest m_activeRequest;
+
+    /*!
+     * \brief Handler of a bus method, resolved once
+     */
+    struct MethodEntry
+    {
+        // Interned, see InternTable
+        QByteArray name;
+        NativeMethod native;
+        QMetaMethod meta;
+    };
+
+    // Keyed on the interned method names. Entries are never removed and
+    // QHash nodes don't move, so a resolved entry stays valid.
+    QHash<QByteArray, MethodEntry> m_dispatch;
+
+    const MethodEntry *resolveMethod(const char *method);
+    bool invokeMethodEntry(const MethodEntry *entry, const QJsonObject& argument, QJsonObject *result);
+    QJsonObject replyObject(const QVariant& returnedValue);
+
+    /*!
+     * \brief Sends the reply of a method handler, adding the request to
+     * the subscriptions of the method unless the reply has an errorCode
+     */
+    static bool sendReply(LSHandle *lshandle, LSMessage *msg, QJsonObject retObj, Service *s,
+                          const QByteArray& subscriptionKey = QByteArray());
+
+    QVariantMap m_subscriptionKeys;
+
+    /*!
+     * \brief The key the request subscribes under, empty for the method
+     * itself
+     */
+    QByteArray subscriptionKey(const char *method, const QJsonObject& message) const;
+    static QByteArray keyedName(const QString& method, const QString& key);
+
+    // Keyed names subscribed to by method, the ones left without
+    // subscribers are dropped when next looked at
+    QHash<QString, QSet<QByteArray>> m_subscribedKeys;
+
+    /*!
+     * \brief The method and its keyed names that have subscribers
+     * \param count Set to the number of subscribers over all of them
+     */
+    QVector<QByteArray> subscriptionTargets(LSHandle *serviceHandle, const QString& method, unsigned int *count = nullptr);
+
+    friend class DeferredReply;
+    ReplyCoalescer *m_coalescer = nullptr;
+
+    QStringList m_pushCoalescedMethods;
+    // Coalesced pushes by method: param and responseMethod
+    QHash<QString, QPair<QString, QString>> m_pendingPushes;
+    QStringList m_pendingPushOrder;
+
+    void pushSubscriptionNow(const QString& method, const QString& param, const QString& responseMethod);
+    void flushPushes();
+
+    ReplyCoalescer *coalescer();
+
     void registerMethods(const QStringList &methods);
     int callInternal(const QString& service,
                      const QString& method,
                      const QString& payload,
                      const QJSValue& timeout,
-                     const QString& sessionId);
+                     const QString& sessionId,
+                     CallFlags flags = AutoDetectCall,
+                     LunaServiceManagerListener *listener = nullptr);
 };
 
 class MessageSpreaderListener: public Service
@@ -358,23 +610,13 @@ public:
     MessageSpreaderListener(QObject *parent);
     virtual ~MessageSpreaderListener();
 
-public slots:
-    void serviceResponseSlot(const QString& method, const QString& payload, int token, const QJsonObject &jsonPayload);
-
-signals:
-    void serviceResponseSignal(const QString& method, const QString& payload, int token, const QJsonObject &jsonPayload);
-
 protected:
-    void serviceResponse(const QString& method, const QString& payload, int token) override final;
+    void serviceResponse(const QString& method, const LunaServiceReply& reply, int token) override final;
+    bool offloadReplies(const QString& method) const override;
     // TODO: Consider this interface moves into LunaServiceManagerListener
-    virtual void serviceResponseDelayed(const QString& method, const QString& payload, int token, const QJsonObject &jsonPayload) = 0;
+    virtual void serviceResponseDelayed(const QString& method, const LunaServiceReply& reply, int token) = 0;
     bool m_spreadEvents = false;
     QStringList m_spreadMethods = {};
-
-private:
-    friend class MessageSpreader;
-    size_t m_handle = 0;
-    bool m_emitted = false;
 };
 
 #endif // SERVICE_H
@@ -36,10 +36,6 @@ static const QLatin1String strCategory("category");
 static const QLatin1String strOption("option");
 static const QLatin1String strScreenRotation("screenRotation");
 static const QLatin1String strLocaleInfo("localeInfo");
-static const QLatin1String strLocales("locales");
-static const QLatin1String strUi("UI");
-static const QLatin1String strStt("STT");
-static const QLatin1String strSettings("settings");
 static const QLatin1String strUnderBar("_");
 static const QLatin1String strHyphen("-");
 static const QLatin1String strFileTypeQm(".qm");
@@ -47,6 +43,17 @@ static const QLatin1String strDot(".");
 static const QLatin1String methodGetSystemSettings("/getSystemSettings");
 static const QLatin1String serviceNameSettings("com.webos.settingsservice");
 
+// Only these few values are read, the replies and files are not parsed whole
+enum SystemSettingsValue { SettingsReturnValue, SettingsErrorCode, SettingsErrorText, SettingsUiLocale, SettingsSttLocale, SettingsScreenRotation };
+static const JsonPathExtractor s_systemSettingsPaths({
+    QStringLiteral("returnValue"), QStringLiteral("errorCode"), QStringLiteral("errorText"),
+    QStringLiteral("settings.localeInfo.locales.UI"), QStringLiteral("settings.localeInfo.locales.STT"),
+    QStringLiteral("settings.screenRotation")});
+enum LocaleInfoValue { LocaleInfoUi, LocaleInfoStt };
+static const JsonPathExtractor s_localeInfoPaths({
+    QStringLiteral("localeInfo.locales.UI"), QStringLiteral("localeInfo.locales.STT")});
+static const JsonPathExtractor s_optionPaths({QStringLiteral("screenRotation")});
+
 /* NOTE
    Translators are cached throughout process alive under same locale information. if the locale is
    changed, the cached are cleared and re-created as the changed locale.
@@ -294,10 +301,10 @@ bool SettingsService::subscribeInternal()
     if (m_tokenLocale != LSMESSAGE_TOKEN_INVALID)
         cancel(m_tokenLocale);
 
-    m_tokenLocale = call(strURIScheme + serviceNameSettings,
+    m_tokenLocale = callWithFlags(strURIScheme + serviceNameSettings,
             methodGetSystemSettings,
             QString(QLatin1String("{\"%1\":%2,\"%3\":[\"%4\"]}")).arg(strSubscribe).arg(strTrue).arg(strKeys).arg(strLocaleInfo),
-            QJSValue(), sessionId());
+            SubscriptionCall, QJSValue(), sessionId());
 
     if (m_tokenLocale == LSMESSAGE_TOKEN_INVALID) {
         qWarning() << "SettingsService: Failed to subscribe to" << strLocaleInfo;
@@ -307,10 +314,10 @@ bool SettingsService::subscribeInternal()
     if (m_tokenSystemSettings != LSMESSAGE_TOKEN_INVALID)
         cancel(m_tokenSystemSettings);
 
-    m_tokenSystemSettings = call(strURIScheme + serviceNameSettings,
+    m_tokenSystemSettings = callWithFlags(strURIScheme + serviceNameSettings,
             methodGetSystemSettings,
             QString(QLatin1String("{\"%1\":%2,\"%3\":\"%4\",\"%5\":[\"%6\"]}")).arg(strSubscribe).arg(strTrue).arg(strCategory).arg(strOption).arg(strKeys).arg(strScreenRotation),
-            QJSValue(), sessionId());
+            SubscriptionCall, QJSValue(), sessionId());
 
     if (m_tokenSystemSettings == LSMESSAGE_TOKEN_INVALID) {
         qWarning() << "SettingsService: Failed to subscribe to" << strScreenRotation;
@@ -344,10 +351,10 @@ bool SettingsService::subscribeBootdInternal()
     if (m_tokenBootd != LSMESSAGE_TOKEN_INVALID)
         cancel(m_tokenBootd);
 
-    m_tokenBootd = call(strURIScheme + serviceNameBootd,
+    m_tokenBootd = callWithFlags(strURIScheme + serviceNameBootd,
             methodGetBootStatus,
             QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
-            QJSValue(), QString("no-session"));
+            SubscriptionCall, QJSValue(), QString("no-session"));
 
     if (m_tokenBootd == LSMESSAGE_TOKEN_INVALID) {
         qWarning() << "SettingsService: Failed to subscribe to" << methodGetBootStatus;
@@ -357,10 +364,16 @@ bool SettingsService::subscribeBootdInternal()
     return true;
 }
 
-void SettingsService::serviceResponseDelayed(const QString& method, const QString& payload, int token, const QJsonObject &rootObject)
+void SettingsService::serviceResponseDelayed(const QString& method, const LunaServiceReply& reply, int token)
 {
+    if (method == methodGetSystemSettings) {
+        systemSettingsResponse(method, reply, token);
+        return;
+    }
+
+    const QJsonObject &rootObject = reply.object();
     checkForErrors(rootObject, token);
-    emit response(method, payload, token);
+    emitResponse(method, reply, token);
 
     if (token < 0) {
         qWarning() << "token is not valid";
@@ -384,27 +397,27 @@ void SettingsService::serviceResponseDelayed(const QString& method, const QStrin
             setCached(true);
 
             QFile fileLocale(G_LOCALE_INFO_FILE);
-            if (fileLocale.open(QFile::ReadOnly | QFile::Text)) {
-                QTextStream in(&fileLocale);
-                QJsonObject object = QJsonDocument::fromJson(in.readAll().toUtf8()).object();
-                if (!object.isEmpty()) {
-                    QString s = object.value(strLocaleInfo).toObject().value(strLocales).toObject().value(strUi).toString();
+            if (fileLocale.open(QFile::ReadOnly)) {
+                bool ok = false;
+                const QVector<QJsonValue> values = s_localeInfoPaths.extract(fileLocale.readAll(), &ok);
+                if (ok && (!values.at(LocaleInfoUi).isUndefined() || !values.at(LocaleInfoStt).isUndefined())) {
+                    QString s = values.at(LocaleInfoUi).toString();
                     qInfo() << "Set currentLocale from" << G_LOCALE_INFO_FILE << ":" << s;
                     setCurrentLocale(s);
 
-                    QString speechToTextLocale = object.value(strLocaleInfo).toObject().value(strLocales).toObject().value(strStt).toString();
+                    QString speechToTextLocale = values.at(LocaleInfoStt).toString();
                     setSpeechToTextLocale(speechToTextLocale);
                 }
             }
             fileLocale.close();
 
             QFile fileOption(G_OPTION_FILE);
-            if (fileOption.open(QFile::ReadOnly | QFile::Text)) {
-                QTextStream in(&fileOption);
-                QJsonObject object = QJsonDocument::fromJson(in.readAll().toUtf8()).object();
-                if (!object.isEmpty()) {
+            if (fileOption.open(QFile::ReadOnly)) {
+                bool ok = false;
+                const QVector<QJsonValue> values = s_optionPaths.extract(fileOption.readAll(), &ok);
+                if (ok && !values.at(0).isUndefined()) {
                     // screenRotation
-                    QString s = object.value(strScreenRotation).toString();
+                    QString s = values.at(0).toString();
                     qInfo() << "Set screenRotation from" << G_OPTION_FILE << ":" << s;
                     setScreenRotation(s);
                 }
@@ -418,32 +431,45 @@ void SettingsService::serviceResponseDelayed(const QString& method, const QStrin
         m_connected = rootObject.value(strConnected).toBool();
         if (m_connected)
             tryToSubscribe();
-    } else if (method == methodGetSystemSettings) {
-        if (!rootObject.value(strReturnValue).toBool())
-            return; //Ignore the subscription failed response
+    }
+}
 
-        setCached(false);
+void SettingsService::systemSettingsResponse(const QString& method, const LunaServiceReply& reply, int token)
+{
+    const QVector<QJsonValue> values = extractValues(reply, s_systemSettingsPaths);
+    checkForErrors(values.at(SettingsErrorCode), values.at(SettingsErrorText), token);
+    emitResponse(method, reply, token);
 
-        if (ul_token == m_tokenLocale) {
-            QString s = rootObject.value(strSettings).toObject().value(strLocaleInfo).toObject().value(strLocales).toObject().value(strUi).toString();
-            qInfo() << "Set currentLocale from LS2 response:" << s;
-            setCurrentLocale(s);
+    if (token < 0) {
+        qWarning() << "token is not valid";
+        return;
+    }
 
-            QString speechToTextLocale = rootObject.value(strSettings).toObject().value(strLocaleInfo).toObject().value(strLocales).toObject().value(strStt).toString();
-            setSpeechToTextLocale(speechToTextLocale);
-        } else if (ul_token == m_tokenSystemSettings) {
-            QString s = rootObject.value(strSettings).toObject().value(strScreenRotation).toString();
-            qInfo() << "Set screenRotation from LS2 response:" << s;
-            setScreenRotation(s);
-        }
+    if (!values.at(SettingsReturnValue).toBool())
+        return; //Ignore the subscription failed response
+
+    setCached(false);
+
+    uint64_t ul_token = (uint64_t) token;
+    if (ul_token == m_tokenLocale) {
+        QString s = values.at(SettingsUiLocale).toString();
+        qInfo() << "Set currentLocale from LS2 response:" << s;
+        setCurrentLocale(s);
+
+        QString speechToTextLocale = values.at(SettingsSttLocale).toString();
+        setSpeechToTextLocale(speechToTextLocale);
+    } else if (ul_token == m_tokenSystemSettings) {
+        QString s = values.at(SettingsScreenRotation).toString();
+        qInfo() << "Set screenRotation from LS2 response:" << s;
+        setScreenRotation(s);
     }
 }
 
-void SettingsService::hubError(const QString& method, const QString& error, const QString& payload, int token)
+void SettingsService::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
 {
     qWarning() << "SettingsService: Hub error:" << error;
 
-    checkForErrors(payload, token);
+    checkForErrors(reply, token);
 
     if (error == LUNABUS_ERROR_SERVICE_DOWN) {
         if (m_subscriptionRequested) {
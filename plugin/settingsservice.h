@@ -107,13 +107,14 @@ protected:
      * the response signal.
      * \param method The method of the service that has been called
        (e.g. "/getSystemSettings")
-     * \param payload The raw JSON reply from the bus
+     * \param reply The reply from the bus
      * \param token Provides the caller's token that is answered
      * by this reply
      */
-    void serviceResponseDelayed(const QString& method, const QString& payload, int token, const QJsonObject &jsonPayload) override;
+    void serviceResponseDelayed(const QString& method, const LunaServiceReply& reply, int token) override;
+    void systemSettingsResponse(const QString& method, const LunaServiceReply& reply, int token);
 
-    void hubError(const QString& method, const QString& error, const QString& payload, int token);
+    void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token);
 
     bool findl10nFileName(const QString& dir, const QString& file, QString &rFilename);
 
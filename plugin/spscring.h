@@ -0,0 +1,107 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SPSCRING_H
+#define SPSCRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <QtGlobal>
+
+    /*!
+     * \class SpscRing
+     * \brief Bounded lock-free ring for one producer and one consumer thread
+     *
+     * The capacity is rounded up to a power of two. push() must only be
+     * called from the producer thread and pop() only from the consumer
+     * thread.
+     */
+
+template <typename T>
+class SpscRing
+{
+public:
+    explicit SpscRing(size_t capacity)
+        : m_head(0)
+        , m_tail(0)
+    {
+        size_t size = 2;
+        while (size < capacity)
+            size <<= 1;
+        m_buffer.resize(size);
+        m_mask = size - 1;
+    }
+
+    /*!
+     * \brief Moves the value into the ring
+     * \return false if the ring is full, the value is left untouched then
+     */
+    bool push(T &value)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_head.load(std::memory_order_acquire) > m_mask)
+            return false;
+
+        m_buffer[tail & m_mask] = std::move(value);
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*!
+     * \brief Moves the oldest value out of the ring
+     * \return false if the ring is empty
+     */
+    bool pop(T &value)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_tail.load(std::memory_order_acquire))
+            return false;
+
+        value = std::move(m_buffer[head & m_mask]);
+        // Release what the slot holds now rather than when it is reused
+        m_buffer[head & m_mask] = T();
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /*!
+     * \brief Number of values in the ring. Exact on the consumer thread
+     * save for the values pushed meanwhile.
+     */
+    size_t size() const
+    {
+        const size_t head = m_head.load(std::memory_order_acquire);
+        return m_tail.load(std::memory_order_acquire) - head;
+    }
+
+    bool isEmpty() const
+    {
+        return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+    }
+
+private:
+    Q_DISABLE_COPY(SpscRing)
+
+    std::vector<T> m_buffer;
+    size_t m_mask;
+    alignas(64) std::atomic<size_t> m_head;
+    alignas(64) std::atomic<size_t> m_tail;
+};
+
+#endif // SPSCRING_H
@@ -0,0 +1,207 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "subscriptionmux.h"
+
+#include <climits>
+
+#include <QDebug>
+
+#include "calltable.h"
+#include "interntable.h"
+
+SubscriptionGroup::SubscriptionGroup(const QString& key, LunaServiceManager *manager)
+    : LunaServiceManagerListener(nullptr)
+    , m_key(key)
+    , m_manager(manager)
+    , m_hasReply(false)
+    , m_closed(false)
+{
+}
+
+void SubscriptionGroup::serviceResponse(const QString& method, const LunaServiceReply& reply, int token)
+{
+    Q_UNUSED(method);
+    Q_UNUSED(token);
+
+    m_lastReply = reply;
+    m_hasReply = true;
+
+    // A handler may cancel members, so walk a copy
+    const QVector<Member> members = m_members;
+    for (const Member &member : members) {
+        // Not replayed yet: the pending replay delivers this reply instead
+        if (member.replayed)
+            deliver(member.token, reply);
+    }
+}
+
+void SubscriptionGroup::hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token)
+{
+    Q_UNUSED(method);
+    Q_UNUSED(token);
+
+    // The subscription is over, the next joiner opens a new one
+    m_closed = true;
+    m_lastReply = LunaServiceReply();
+    m_hasReply = false;
+    SubscriptionMux::instance()->forget(this);
+
+    const QVector<Member> members = m_members;
+    for (const Member &member : members) {
+        const CallTable::Slot *slot = CallTable::instance()->find(static_cast<LSHandle *>(nullptr), member.token);
+        if (!slot)
+            continue;
+
+        LunaServiceManagerListener *listener = slot->listener;
+        LunaServiceManager::routeHubError(listener, *slot->method, error, reply, (int) member.token, nullptr);
+    }
+}
+
+void SubscriptionGroup::replay(LSMessageToken token)
+{
+    int i = 0;
+    while (i < m_members.size() && m_members.at(i).token != token)
+        i++;
+
+    if (i == m_members.size() || m_members.at(i).replayed)
+        return;
+
+    m_members[i].replayed = true;
+
+    if (m_hasReply)
+        deliver(token, m_lastReply);
+}
+
+void SubscriptionGroup::deliver(LSMessageToken token, const LunaServiceReply& reply)
+{
+    const CallTable::Slot *slot = CallTable::instance()->find(static_cast<LSHandle *>(nullptr), token);
+    if (!slot)
+        return;
+
+    LunaServiceManagerListener *listener = slot->listener;
+    const QString &method = *slot->method;
+
+    // Each member coalesces, offloads and orders its replies on its own.
+    // The bus metrics count the reply once, under the call of the group.
+    if (listener->coalesceReply(method, reply, (int) token, nullptr))
+        return;
+
+    LunaServiceManager::routeReply(listener, method, reply, (int) token, nullptr);
+}
+
+SubscriptionMux *SubscriptionMux::instance()
+{
+    static SubscriptionMux s_instance;
+    return &s_instance;
+}
+
+bool SubscriptionMux::isEnabled()
+{
+    static const bool s_enabled = qgetenv("WEBOS_QML_WEBOSSERVICES_SHARE_SUBSCRIPTIONS") != "0";
+    return s_enabled;
+}
+
+SubscriptionMux::SubscriptionMux()
+    : m_nextToken(INT_MAX)
+{
+}
+
+LSMessageToken SubscriptionMux::nextToken()
+{
+    // Virtual tokens count down from INT_MAX, away from the LS2 ones
+    do {
+        if (--m_nextToken == LSMESSAGE_TOKEN_INVALID)
+            m_nextToken = INT_MAX;
+    } while (m_members.contains(m_nextToken));
+
+    return m_nextToken;
+}
+
+LSMessageToken SubscriptionMux::join(LunaServiceManager *manager, const QString& service, const QString& method,
+                                     const QString& payload, const QString& sessionId, LunaServiceManagerListener *listener)
+{
+    // The payloads are built from the same templates, identical calls send
+    // identical strings
+    const QString key = QString::number((quintptr) manager->getServiceHandle(), 16)
+            + QLatin1Char('\n') + service + method
+            + QLatin1Char('\n') + payload
+            + QLatin1Char('\n') + sessionId;
+
+    SubscriptionGroup *group = m_groups.value(key);
+    if (!group || group->m_closed) {
+        group = new SubscriptionGroup(key, manager);
+        LSMessageToken token = manager->call(service, method, payload, group, sessionId,
+                                             SubscriptionCall | ExclusiveCall);
+        if (token == LSMESSAGE_TOKEN_INVALID) {
+            delete group;
+            return LSMESSAGE_TOKEN_INVALID;
+        }
+        // A closed group keeps serving its members but takes no new ones
+        m_groups.insert(key, group);
+    }
+
+    const LSMessageToken token = nextToken();
+
+    CallTable::Slot call;
+    call.token = token;
+    call.listener = listener;
+    call.subscription = true;
+    call.method = &InternTable::name(method);
+    CallTable::instance()->insert(call);
+
+    const bool replay = group->m_hasReply;
+    SubscriptionGroup::Member member;
+    member.token = token;
+    member.replayed = !replay;
+    group->m_members.append(member);
+    m_members.insert(token, group);
+
+    // Delivered later, like a reply, rather than from within the call
+    if (replay)
+        QMetaObject::invokeMethod(group, [group, token]() { group->replay(token); }, Qt::QueuedConnection);
+
+    return token;
+}
+
+void SubscriptionMux::leave(LSMessageToken token)
+{
+    SubscriptionGroup *group = m_members.take(token);
+    if (!group)
+        return;
+
+    for (int i = 0; i < group->m_members.size(); i++) {
+        if (group->m_members.at(i).token == token) {
+            group->m_members.remove(i);
+            break;
+        }
+    }
+
+    if (!group->m_members.isEmpty())
+        return;
+
+    forget(group);
+
+    group->m_manager->cancel(group);
+    // May be called from within the fan out of the group
+    group->deleteLater();
+}
+
+void SubscriptionMux::forget(SubscriptionGroup *group)
+{
+    if (m_groups.value(group->m_key) == group)
+        m_groups.remove(group->m_key);
+}
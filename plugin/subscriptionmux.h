@@ -0,0 +1,128 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef SUBSCRIPTIONMUX_H
+#define SUBSCRIPTIONMUX_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+#include <luna-service2/lunaservice.h>
+
+#include "lunaservicemgr.h"
+
+class LunaServiceManager;
+
+    /*!
+     * \class SubscriptionGroup
+     * \brief One LS2 subscription shared by several listeners
+     *
+     * The group is the listener of the real call and fans every reply out
+     * to its members. Each member is known by a virtual token that is
+     * registered in CallTable without a handle, so the members see the
+     * same token semantics as for a call of their own.
+     *
+     * The latest reply is kept so that a late joiner is replayed the
+     * current state rather than waiting for the next change. Only that
+     * reply is kept, an event a member has already seen is never sent
+     * again. A hub error ends the group and the next joiner starts a new
+     * one.
+     */
+
+class SubscriptionGroup : public LunaServiceManagerListener
+{
+public:
+    SubscriptionGroup(const QString& key, LunaServiceManager *manager);
+
+    void serviceResponse(const QString& method, const LunaServiceReply& reply, int token) override;
+    void hubError(const QString& method, const QString& error, const LunaServiceReply& reply, int token) override;
+
+private:
+    friend class SubscriptionMux;
+
+    struct Member
+    {
+        LSMessageToken token;
+        bool replayed;
+    };
+
+    void replay(LSMessageToken token);
+    void deliver(LSMessageToken token, const LunaServiceReply& reply);
+
+    QString m_key;
+    LunaServiceManager *m_manager;
+    QVector<Member> m_members;
+    LunaServiceReply m_lastReply;
+    bool m_hasReply;
+    bool m_closed;
+};
+
+    /*!
+     * \class SubscriptionMux
+     * \brief Shares identical subscriptions across the listeners
+     *
+     * Subscriptions are keyed on the LS2 handle, the service, the method,
+     * the payload as sent and the session id. The first listener opens
+     * the LS2 subscription, the others join it and the
+     * subscription is cancelled when the last member leaves.
+     *
+     * Sharing is on by default and can be turned off by setting
+     * WEBOS_QML_WEBOSSERVICES_SHARE_SUBSCRIPTIONS=0. A single call opts
+     * out with the ExclusiveCall flag.
+     *
+     * Like CallTable it must only be used from the GUI thread.
+     *
+     * \see LunaServiceManager
+     */
+
+class SubscriptionMux
+{
+public:
+    static SubscriptionMux *instance();
+
+    static bool isEnabled();
+
+    /*!
+     * \brief Subscribes the listener through a shared subscription
+     *
+     * \return The virtual token of the listener or LSMESSAGE_TOKEN_INVALID
+     * if the subscription could not be opened
+     */
+    LSMessageToken join(LunaServiceManager *manager, const QString& service, const QString& method,
+                        const QString& payload, const QString& sessionId, LunaServiceManagerListener *listener);
+
+    /*!
+     * \brief Removes a member. Its CallTable slot must already be gone.
+     */
+    void leave(LSMessageToken token);
+
+    bool contains(LSMessageToken token) const { return m_members.contains(token); }
+
+private:
+    SubscriptionMux();
+
+    friend class SubscriptionGroup;
+
+    LSMessageToken nextToken();
+    // Takes no new members into the group
+    void forget(SubscriptionGroup *group);
+
+    QHash<QString, SubscriptionGroup *> m_groups;
+    QHash<LSMessageToken, SubscriptionGroup *> m_members;
+    LSMessageToken m_nextToken;
+};
+
+#endif // SUBSCRIPTIONMUX_H
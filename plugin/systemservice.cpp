@@ -77,9 +77,10 @@ int SystemService::lockTimeout()
 
 QDateTime SystemService::systemTime()
 {
-    call(serviceUri(),
+    callWithFlags(serviceUri(),
          methodTimeGetSystemTime,
-         QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue));
+         QString(QLatin1String("{\"%1\":%2}")).arg(strSubscribe).arg(strTrue),
+         SubscriptionCall);
     return m_systemTime;
 }
 
@@ -116,27 +117,34 @@ void SystemService::setLockTimeout(int seconds)
 
 void SystemService::getPreference(const QString& key)
 {
-    call(serviceUri(),
+    callWithFlags(serviceUri(),
          methodGetPreferences,
-         QString(QLatin1String("{\"%1\":[\"%2\"], \"%3\":%4}")).arg(strKeys).arg(key).arg(strSubscribe).arg(strTrue));
+         QString(QLatin1String("{\"%1\":[\"%2\"], \"%3\":%4}")).arg(strKeys).arg(key).arg(strSubscribe).arg(strTrue),
+         SubscriptionCall);
 }
 
 void SystemService::setPreference(const QString& key, const QString& value)
 {
-    call(serviceUri(),
+    callWithFlags(serviceUri(),
          methodSetPreferences,
-         QString(QLatin1String("{\"%1\":%2}")).arg(key).arg(value));
+         QString(QLatin1String("{\"%1\":%2}")).arg(key).arg(value),
+         OneReplyCall);
 }
 
-void SystemService::serviceResponse( const QString& method, const QString& payload, int token )
+void SystemService::serviceResponse( const QString& method, const LunaServiceReply& reply, int token )
 {
-    checkForErrors(payload, token);
-    Q_EMIT response(method, payload, token);
+    if ( method == methodTimeGetSystemTime ) {
+        systemTimeResponse(method, reply, token);
+        return;
+    }
+
+    checkForErrors(reply, token);
+    emitResponse(method, reply, token);
 
     // qDebug() << Q_FUNC_INFO << "objectName: " << objectName() << "method: " <<  method << "payload: " << payload;
 
     if ( method == methodGetPreferences || method == methodSetPreferences) {
-        QJsonObject rootObject = QJsonDocument::fromJson(payload.toUtf8()).object();
+        QJsonObject rootObject = reply.object();
 
         rootObject.take(strReturnValue);
 
@@ -173,19 +181,27 @@ void SystemService::serviceResponse( const QString& method, const QString& paylo
                                            m_lockTimeout = lockTimeout;
                                            emit lockTimeoutChanged(); }
     }
-    else if ( method == methodTimeGetSystemTime ) {
-        QJsonObject rootObject = QJsonDocument::fromJson(payload.toUtf8()).object();
-
-        int systemSeconds = rootObject.value(strUtc).toDouble();
-        QDateTime systemTime = QDateTime::fromMSecsSinceEpoch((qint64)systemSeconds * 1000, Qt::LocalTime);
-        m_systemTime = systemTime;
-        emit systemTimeChanged();
-    }
     else {
         qWarning() << "Unknown method";
     }
 }
 
+void SystemService::systemTimeResponse( const QString& method, const LunaServiceReply& reply, int token )
+{
+    // Sent every minute and only utc is used, read it without parsing the reply
+    enum { ErrorCode, ErrorText, Utc };
+    static const JsonPathExtractor s_paths({strErrorCode, strErrorText, strUtc});
+
+    const QVector<QJsonValue> values = extractValues(reply, s_paths);
+    checkForErrors(values.at(ErrorCode), values.at(ErrorText), token);
+    emitResponse(method, reply, token);
+
+    int systemSeconds = values.at(Utc).toDouble();
+    QDateTime systemTime = QDateTime::fromMSecsSinceEpoch((qint64)systemSeconds * 1000, Qt::LocalTime);
+    m_systemTime = systemTime;
+    emit systemTimeChanged();
+}
+
 QString SystemService::interfaceName() const
 {
     return QString(serviceName);
@@ -59,7 +59,8 @@ public:
     int lockTimeout();
     QDateTime systemTime();
 
-    void serviceResponse(const QString& method, const QString& payload, int token);
+    void serviceResponse(const QString& method, const LunaServiceReply& reply, int token);
+    void systemTimeResponse(const QString& method, const LunaServiceReply& reply, int token);
 
     QString interfaceName() const;
 
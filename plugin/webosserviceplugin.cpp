@@ -17,12 +17,25 @@
 #include "webosserviceplugin.h"
 
 #include <QQmlComponent>
+#include <QQmlEngine>
 
 #include "applicationmanagerservice.h"
 #include "systemservice.h"
 #include "notificationservice.h"
 #include "settingsservice.h"
 #include "servicemodel.h"
+#include "busmetrics.h"
+#include "launchpointslistmodel.h"
+#include "applicationmanagermodels.h"
+#include "deferredreply.h"
+
+static QObject *busMetricsProvider(QQmlEngine *engine, QJSEngine *scriptEngine)
+{
+    Q_UNUSED(scriptEngine)
+    BusMetrics *metrics = BusMetrics::instance();
+    engine->setObjectOwnership(metrics, QQmlEngine::CppOwnership);
+    return metrics;
+}
 
 void WebOSServicePlugin::registerTypes(const char *uri)
 {
@@ -33,5 +46,11 @@ void WebOSServicePlugin::registerTypes(const char *uri)
     qmlRegisterType<SettingsService>("WebOSServices", 1,0, "LocaleService"); // superceded by SettingsService
     qmlRegisterType<SettingsService>("WebOSServices", 1,0, "SettingsService");
     qmlRegisterType<Service>("WebOSServices", 1,0, "Service");
+    qmlRegisterType<LaunchPointsListModel>("WebOSServices", 1,0, "LaunchPointsListModel");
+    qmlRegisterType<RunningProcessesModel>("WebOSServices", 1,0, "RunningProcessesModel");
+    qmlRegisterType<InstalledAppsModel>("WebOSServices", 1,0, "InstalledAppsModel");
+    qmlRegisterType<InstalledPackagesModel>("WebOSServices", 1,0, "InstalledPackagesModel");
     qmlRegisterUncreatableType<ServiceModel>("WebOSServices", 1,0, "ServiceModel", "Abstract type");
+    qmlRegisterUncreatableType<DeferredReply>("WebOSServices", 1,0, "DeferredReply", "Returned by Service.defer()");
+    qmlRegisterSingletonType<BusMetrics>("WebOSServices", 1,0, "BusMetrics", busMetricsProvider);
 }
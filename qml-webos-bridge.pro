@@ -21,6 +21,11 @@ OBJECTS_DIR = .obj
 
 SUBDIRS = plugin
 
+# Unit tests and benchmarks, run with make check
+tests {
+    SUBDIRS += tests
+}
+
 load(configure)
 qtCompileTest(session)
 
@@ -34,13 +39,10 @@ QML_FILES +=  \
     $$PWD/qml/models/ToastModel.qml \
     $$PWD/qml/models/PackagesListModel.qml \
     $$PWD/qml/models/InputAlertModel.qml \
-    $$PWD/qml/models/RunningModel.js \
     $$PWD/qml/models/PincodePromptModel.js \
-    $$PWD/qml/models/PackagesListModel.js \
     $$PWD/qml/models/AlertModel.js \
     $$PWD/qml/models/ToastModel.js \
     $$PWD/qml/models/InputAlertModel.js \
-    $$PWD/qml/models/ApplicationListModel.js \
 
 # The WEBOS_INSTALL_QML Qt variable must be set in the build
 # environment by qmake WEBOS_INSTALL_QML=<location>
@@ -16,13 +16,9 @@
 
 import QtQuick 2.0
 import WebOSServices 1.0
-import "ApplicationListModel.js" as JS
 
-ListModel {
+InstalledAppsModel {
     id: listModel
     property var applicationManagerService: ApplicationManagerService {}
-    property string source: applicationManagerService.applicationList
-    property var jsonSource: applicationManagerService.jsonApplicationList
-
-    onSourceChanged: JS.load()
+    service: applicationManagerService
 }
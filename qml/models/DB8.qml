@@ -19,37 +19,62 @@ import WebOSServices 1.0
 
 Service {
     id:db8
-    property var callbacks: []
-    onResponse: (method, payload, token) => { handleResponse(method, payload, token); }
+    property var batchCalls: null
+    property var batchCallbacks: ({})
+    onBatchCompleted: (batchId, results) => { handleBatchCompleted(batchId, results); }
 
-    function handleResponse(method, payload, token)
+    function dispatchCallback(callback, method, json)
     {
-        var json = JSON.parse(payload);
-        var callback;
-
-        for (var i = 0; i < callbacks.length; i++) {
-            if (callbacks[i].token == token) {
-                callback = callbacks.splice(i, 1)[0];
-                break;
-            }
+        if(json.returnValue == true && callback.success) {
+            callback.success(json);
+        } else if(json.returnValue == false && callback.failure) {
+            callback.failure(json);
+        } else {
+            console.log("DB8 " +appId+ " unhandled response from call to "+method+":"+JSON.stringify(json));
         }
+    }
+
+    function handleBatchCompleted(batchId, results)
+    {
+        var calls = batchCallbacks[batchId];
+        if (calls === undefined)
+            return;
+        delete batchCallbacks[batchId];
 
-        if(callback) {
-            if(json.returnValue == true && callback.success) {
-                callback.success(json);
-            } else if(json.returnValue == false && callback.failure) {
-                callback.failure(json);
-            } else {
-                console.log("DB8 " +appId+ " unhandled response from call to "+method+":"+payload);
-            }
+        for (var i = 0; i < results.length; i++) {
+            dispatchCallback(calls[i], results[i].method, results[i].response);
         }
     }
 
+    // Calls made between beginBatch() and commitBatch() are issued together
+    // and their callbacks run when all of them are answered
+    function beginBatch() {
+        batchCalls = [];
+    }
+
+    function commitBatch() {
+        var calls = batchCalls;
+        batchCalls = null;
+        if (calls === null || calls.length === 0)
+            return;
+
+        var batchId = callBatch(calls.map(function(c) {
+            return { "service": "luna://com.palm.db", "method": c.method, "payload": c.payload };
+        }));
+        if (batchId !== 0)
+            batchCallbacks[batchId] = calls;
+    }
+
     function callDB(func, args, onSuccess, onFailure) {
-        var ret = call("luna://com.palm.db",
-        func,
-        JSON.stringify(args));
-        callbacks.push({token:ret, success:onSuccess, failure:onFailure});
+        if (batchCalls !== null) {
+            batchCalls.push({method:func, payload:JSON.stringify(args), success:onSuccess, failure:onFailure});
+            return;
+        }
+
+        var callback = {success:onSuccess, failure:onFailure};
+        request("luna://com.palm.db", func, JSON.stringify(args)).then(
+            function(json) { dispatchCallback(callback, func, json); },
+            function(json) { dispatchCallback(callback, func, json); });
     }
 
     function delKind(args, onSuccess, onFailure) {
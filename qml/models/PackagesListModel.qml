@@ -15,13 +15,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 import QtQuick 2.0
-import "PackagesListModel.js" as JS
 import WebOSServices 1.0
 
-ListModel {
+InstalledPackagesModel {
     id: listModel
     property var applicationManagerService: ApplicationManagerService {}
-    property string source: applicationManagerService.packagesList
-
-    onSourceChanged: JS.load()
+    service: applicationManagerService
 }
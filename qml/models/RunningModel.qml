@@ -15,13 +15,10 @@
 // SPDX-License-Identifier: Apache-2.0
 
 import QtQuick 2.0
-import "RunningModel.js" as JS
 import WebOSServices 1.0
 
-ListModel {
+RunningProcessesModel {
     id: listModel
     property var applicationManagerService: ApplicationManagerService {}
-    property string source: applicationManagerService.runningList
-
-    onSourceChanged: JS.load()
+    service: applicationManagerService
 }
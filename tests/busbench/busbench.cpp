@@ -0,0 +1,407 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+// End-to-end throughput of the bridge over the luna-service2 stand-in.
+// Each scenario sends replies to a Service, an ApplicationManagerService
+// or a SettingsService and reports the replies per second, the latency
+// from the reply leaving the bus to the response signal, and the peak
+// RSS of the process. Set WEBOS_QML_WEBOSSERVICES_BUS_THREAD=1 and the
+// other switches of the bridge as for an application.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdio>
+
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLoggingCategory>
+#include <QPointer>
+#include <QQueue>
+#include <QTimer>
+
+#include "applicationmanagerservice.h"
+#include "lunaservicestub.h"
+#include "service.h"
+#include "settingsservice.h"
+
+static const char strServerStatusUri[] = "luna://com.webos.service.bus/signal/registerServerStatus";
+static const char strBootStatusUri[] = "luna://com.webos.bootManager/getBootStatus";
+static const char strLaunchPointsUri[] = "luna://com.webos.applicationManager/listLaunchPoints";
+static const char strSystemSettingsUri[] = "luna://com.webos.settingsservice/getSystemSettings";
+static const QLatin1String strProvider("com.webos.bench.provider");
+static const QLatin1String strProviderUri("luna://com.webos.bench.provider");
+static const QLatin1String strEcho("echo");
+static const QLatin1String strEchoMethod("/echo");
+
+// A scenario without progress for that long has stalled
+static const qint64 s_stallMs = 10000;
+
+struct Options
+{
+    QStringList scenarios;
+    // Replies per second, 0 for as many as the bridge takes
+    double rate;
+    int payloadSize;
+    int count;
+    // Replies in flight when there is no rate
+    int window;
+};
+
+static QByteArray padding(int size)
+{
+    return QByteArray(std::max(0, size), 'x');
+}
+
+// Two lists that differ by a title, so that every reply is a change
+static QByteArray launchPoints(int size, int variant)
+{
+    QByteArray entries;
+    int i = 0;
+    do {
+        if (i)
+            entries += ',';
+        entries += QByteArray("{\"id\":\"com.webos.bench.app") + QByteArray::number(i)
+                + "\",\"title\":\"App " + QByteArray::number(i) + (i == 0 && variant ? " *" : "")
+                + "\",\"icon\":\"/usr/palm/applications/com.webos.bench.app" + QByteArray::number(i)
+                + "/icon.png\",\"removable\":true}";
+        ++i;
+    } while (entries.size() < size - 48);
+
+    return "{\"returnValue\":true,\"subscribed\":true,\"launchPoints\":[" + entries + "]}";
+}
+
+static QByteArray systemSettings(int size, int variant)
+{
+    const QByteArray settings = QByteArray("{\"returnValue\":true,\"subscribed\":true,\"method\":\"getSystemSettings\","
+                                           "\"settings\":{\"localeInfo\":{\"locales\":{\"UI\":\"en-US\",\"STT\":\"en-US\"}},"
+                                           "\"screenRotation\":\"") + (variant ? "90" : "off") + "\"},\"padding\":\"";
+    return settings + padding(size - settings.size() - 2) + "\"}";
+}
+
+static long peakRssKb()
+{
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return -1;
+    return usage.ru_maxrss;
+}
+
+class Bench : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit Bench(const Options& options);
+    ~Bench();
+
+    void start();
+
+private Q_SLOTS:
+    void response(const QString& method, const QString& payload, int token);
+    void cancelled(int token);
+    void tick();
+
+private:
+    void answer(const LunaServiceStub::Call& call);
+    void runNext();
+    void send();
+    void finish();
+    void watch(Service *service);
+
+    Options m_options;
+    QStringList m_queue;
+    QString m_scenario;
+    QList<QPointer<Service>> m_services;
+    QPointer<Service> m_caller;
+
+    // Replies of the feeds, alternated
+    std::string m_replies[2];
+    QString m_request;
+    QByteArray m_feedUri;
+    QList<LSMessageToken> m_feeds;
+
+    // Send times of the replies in flight, per call
+    QHash<int, QQueue<qint64>> m_inFlight;
+    QVector<qint64> m_latencies;
+    int m_sent;
+    int m_received;
+
+    QElapsedTimer m_clock;
+    qint64 m_start;
+    qint64 m_progress;
+    QTimer m_ticker;
+};
+
+Bench::Bench(const Options& options)
+    : m_options(options)
+    , m_sent(0)
+    , m_received(0)
+    , m_start(0)
+    , m_progress(0)
+{
+    m_clock.start();
+    m_ticker.setInterval(1);
+    connect(&m_ticker, &QTimer::timeout, this, &Bench::tick);
+
+    LunaServiceStub::setResponder([this](const LunaServiceStub::Call& call) { answer(call); });
+}
+
+Bench::~Bench()
+{
+    LunaServiceStub::reset();
+}
+
+void Bench::start()
+{
+    m_queue = m_options.scenarios;
+    runNext();
+}
+
+// Stands in for the services the bridge calls
+void Bench::answer(const LunaServiceStub::Call& call)
+{
+    if (call.uri == strServerStatusUri) {
+        const QJsonObject request = QJsonDocument::fromJson(QByteArray::fromStdString(call.payload)).object();
+        QJsonObject status;
+        status.insert(QStringLiteral("serviceName"), request.value(QStringLiteral("serviceName")));
+        status.insert(QStringLiteral("connected"), true);
+        status.insert(QStringLiteral("returnValue"), true);
+        LunaServiceStub::reply(call.token, QJsonDocument(status).toJson(QJsonDocument::Compact).toStdString());
+    } else if (call.uri == strBootStatusUri) {
+        LunaServiceStub::reply(call.token, "{\"returnValue\":true,\"subscribed\":true,\"bootStatus\":\"normal\"}");
+    } else if (!m_feedUri.isEmpty() && call.uri == m_feedUri.constData()) {
+        // Fed from tick()
+        m_feeds.append(call.token);
+    } else {
+        LunaServiceStub::reply(call.token, "{\"returnValue\":true}");
+    }
+}
+
+void Bench::watch(Service *service)
+{
+    m_services.append(service);
+    connect(service, &Service::response, this, &Bench::response);
+    connect(service, &Service::cancelled, this, &Bench::cancelled);
+}
+
+void Bench::runNext()
+{
+    if (m_queue.isEmpty()) {
+        QCoreApplication::quit();
+        return;
+    }
+
+    m_scenario = m_queue.takeFirst();
+    m_sent = 0;
+    m_received = 0;
+    m_latencies.clear();
+    m_latencies.reserve(m_options.count);
+    m_inFlight.clear();
+    m_feeds.clear();
+    m_feedUri.clear();
+
+    if (m_scenario == QLatin1String("service")) {
+        // A bus method of one Service called by another one
+        Service *provider = new Service(this);
+        provider->setAppId(strProvider);
+        QJsonObject reply;
+        reply.insert(QStringLiteral("returnValue"), true);
+        reply.insert(QStringLiteral("data"), QString::fromLatin1(padding(m_options.payloadSize - 32)));
+        provider->setNativeMethod(strEcho, [reply](const QJsonObject&) { return reply; });
+        provider->setMethods(QStringList() << strEcho);
+        m_services.append(provider);
+
+        m_caller = new Service(this);
+        m_caller->setAppId(QStringLiteral("com.webos.bench.caller"));
+        watch(m_caller);
+        m_request = QStringLiteral("{\"data\":\"%1\"}").arg(QString::fromLatin1(padding(m_options.payloadSize - 12)));
+    } else if (m_scenario == QLatin1String("applicationmanager")) {
+        m_feedUri = strLaunchPointsUri;
+        m_replies[0] = launchPoints(m_options.payloadSize, 0).toStdString();
+        m_replies[1] = launchPoints(m_options.payloadSize, 1).toStdString();
+
+        ApplicationManagerService *applicationManager = new ApplicationManagerService(this);
+        watch(applicationManager);
+        applicationManager->setAppId(QStringLiteral("com.webos.bench.applicationmanager"));
+        applicationManager->subscribeLaunchPointsList();
+    } else if (m_scenario == QLatin1String("settings")) {
+        m_feedUri = strSystemSettingsUri;
+        m_replies[0] = systemSettings(m_options.payloadSize, 0).toStdString();
+        m_replies[1] = systemSettings(m_options.payloadSize, 1).toStdString();
+
+        SettingsService *settings = new SettingsService(this);
+        watch(settings);
+        settings->setAppId(QStringLiteral("com.webos.bench.settings"));
+        settings->subscribe();
+    } else {
+        fprintf(stderr, "Unknown scenario %s\n", qPrintable(m_scenario));
+        QCoreApplication::exit(1);
+        return;
+    }
+
+    m_start = m_clock.nsecsElapsed();
+    m_progress = m_start;
+    m_ticker.start();
+    send();
+}
+
+void Bench::tick()
+{
+    if ((m_clock.nsecsElapsed() - m_progress) / 1000000 > s_stallMs) {
+        fprintf(stderr, "%s stalled after %d of %d replies\n", qPrintable(m_scenario), m_received, m_options.count);
+        m_ticker.stop();
+        QCoreApplication::exit(1);
+        return;
+    }
+
+    send();
+}
+
+// Sends the replies that are due, or issues the calls
+void Bench::send()
+{
+    int due = m_received + m_options.window;
+    if (m_options.rate > 0)
+        due = 1 + static_cast<int>((m_clock.nsecsElapsed() - m_start) * m_options.rate / 1e9);
+    due = std::min(due, m_options.count);
+
+    while (m_sent < due) {
+        if (m_caller) {
+            const qint64 now = m_clock.nsecsElapsed();
+            const int token = m_caller->call(strProviderUri, strEchoMethod, m_request);
+            if (token == LSMESSAGE_TOKEN_INVALID)
+                return;
+            m_inFlight[token].enqueue(now);
+        } else {
+            if (m_feeds.isEmpty())
+                return;
+
+            // Round robin over the subscriptions to the URI
+            const LSMessageToken token = m_feeds.at(m_sent % m_feeds.size());
+            const qint64 now = m_clock.nsecsElapsed();
+            if (!LunaServiceStub::reply(token, m_replies[m_sent % 2])) {
+                cancelled(token);
+                continue;
+            }
+            m_inFlight[token].enqueue(now);
+        }
+        ++m_sent;
+    }
+}
+
+void Bench::response(const QString& method, const QString& payload, int token)
+{
+    Q_UNUSED(method);
+    Q_UNUSED(payload);
+
+    QHash<int, QQueue<qint64>>::iterator it = m_inFlight.find(token);
+    if (it == m_inFlight.end() || it->isEmpty())
+        return;
+
+    const qint64 now = m_clock.nsecsElapsed();
+    m_latencies.append(now - it->dequeue());
+    m_progress = now;
+
+    if (++m_received == m_options.count)
+        finish();
+    else if (m_options.rate <= 0)
+        send();
+}
+
+// The subscription was replaced, e.g. by SettingsService when it subscribes
+// again, and the replies in flight to it are lost
+void Bench::cancelled(int token)
+{
+    if (!m_feeds.removeAll(token))
+        return;
+
+    m_sent -= m_inFlight.take(token).size();
+}
+
+void Bench::finish()
+{
+    m_ticker.stop();
+
+    const double seconds = (m_clock.nsecsElapsed() - m_start) / 1e9;
+    std::sort(m_latencies.begin(), m_latencies.end());
+    const int n = m_latencies.size();
+    const double p50 = m_latencies.at(std::min(n - 1, n / 2)) / 1e3;
+    const double p99 = m_latencies.at(std::min(n - 1, n * 99 / 100)) / 1e3;
+
+    printf("%-20s %8d replies of %6d bytes %10.0f calls/s   p50 %9.1f us   p99 %9.1f us   peak RSS %7ld kB\n",
+           qPrintable(m_scenario), n, m_options.payloadSize, n / seconds, p50, p99, peakRssKb());
+    fflush(stdout);
+
+    for (const QPointer<Service>& service : m_services) {
+        if (service) {
+            service->cancel();
+            service->deleteLater();
+        }
+    }
+    m_services.clear();
+    m_caller = nullptr;
+
+    // After the deletions
+    QTimer::singleShot(0, this, &Bench::runNext);
+}
+
+int main(int argc, char *argv[])
+{
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(QStringLiteral("Throughput of the bridge over the luna-service2 stand-in"));
+    parser.addHelpOption();
+    QCommandLineOption scenarioOption(QStringList() << QStringLiteral("s") << QStringLiteral("scenario"),
+            QStringLiteral("Comma separated scenarios: service, applicationmanager, settings."),
+            QStringLiteral("names"), QStringLiteral("service,applicationmanager,settings"));
+    QCommandLineOption rateOption(QStringList() << QStringLiteral("r") << QStringLiteral("rate"),
+            QStringLiteral("Replies per second, 0 for as fast as they are taken."), QStringLiteral("rate"), QStringLiteral("0"));
+    QCommandLineOption payloadOption(QStringList() << QStringLiteral("p") << QStringLiteral("payload"),
+            QStringLiteral("Size of the replies in bytes."), QStringLiteral("bytes"), QStringLiteral("1024"));
+    QCommandLineOption countOption(QStringList() << QStringLiteral("n") << QStringLiteral("count"),
+            QStringLiteral("Replies per scenario."), QStringLiteral("count"), QStringLiteral("10000"));
+    QCommandLineOption windowOption(QStringList() << QStringLiteral("w") << QStringLiteral("window"),
+            QStringLiteral("Replies in flight without a rate."), QStringLiteral("count"), QStringLiteral("16"));
+    parser.addOptions(QList<QCommandLineOption>() << scenarioOption << rateOption << payloadOption << countOption << windowOption);
+    parser.process(app);
+
+    Options options;
+    options.scenarios = parser.value(scenarioOption).split(QLatin1Char(','), QString::SkipEmptyParts);
+    options.rate = parser.value(rateOption).toDouble();
+    options.payloadSize = parser.value(payloadOption).toInt();
+    options.count = std::max(1, parser.value(countOption).toInt());
+    options.window = std::max(1, parser.value(windowOption).toInt());
+
+    // The bridge logs every settings reply
+    if (qEnvironmentVariableIsEmpty("QT_LOGGING_RULES"))
+        QLoggingCategory::setFilterRules(QStringLiteral("*.debug=false\n*.info=false"));
+
+    Bench bench(options);
+    QTimer::singleShot(0, &bench, &Bench::start);
+    return app.exec();
+}
+
+#include "busbench.moc"
@@ -0,0 +1,34 @@
+# Copyright (c) 2026 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+
+# Throughput benchmark of the bridge over the luna-service2 stand-in, run
+# by hand, see busbench --help. Not a test case, make check skips it.
+
+TEMPLATE = app
+TARGET = busbench
+
+QT += gui
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+MOC_DIR = .moc
+OBJECTS_DIR = .obj
+
+include(../lunaservicestub/lunaservicestub.pri)
+include(../../plugin/plugin.pri)
+
+SOURCES += busbench.cpp
@@ -0,0 +1,127 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QtTest>
+
+#include "lunaservicemgr.h"
+
+class tst_CallFlags : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void isSubscriptionPayload_data();
+    void isSubscriptionPayload();
+
+    void scanPayload_data();
+    void scanPayload();
+    void parsePayload_data();
+    void parsePayload();
+};
+
+void tst_CallFlags::isSubscriptionPayload_data()
+{
+    QTest::addColumn<QString>("payload");
+    QTest::addColumn<bool>("subscription");
+
+    QTest::newRow("subscribe") << QStringLiteral("{\"subscribe\":true}") << true;
+    QTest::newRow("watch") << QStringLiteral("{\"watch\":true}") << true;
+    QTest::newRow("spaces") << QStringLiteral("{\n  \"subscribe\"\t:\ttrue\n}") << true;
+    QTest::newRow("last key") << QStringLiteral("{\"keys\":[\"a\",\"b\"],\"options\":{\"x\":1},\"subscribe\":true}") << true;
+    QTest::newRow("escaped string before") << QStringLiteral("{\"x\":\"\\\"subscribe\\\":true\",\"subscribe\" : true}") << true;
+    QTest::newRow("false") << QStringLiteral("{\"subscribe\":false}") << false;
+    QTest::newRow("string") << QStringLiteral("{\"subscribe\":\"true\"}") << false;
+    QTest::newRow("number") << QStringLiteral("{\"subscribe\":1}") << false;
+    QTest::newRow("nested") << QStringLiteral("{\"query\":{\"subscribe\":true},\"limit\":1}") << false;
+    QTest::newRow("in array") << QStringLiteral("{\"list\":[{\"watch\":true}]}") << false;
+    QTest::newRow("in string") << QStringLiteral("{\"text\":\"\\\"subscribe\\\":true\"}") << false;
+    QTest::newRow("other key") << QStringLiteral("{\"subscribed\":true}") << false;
+    QTest::newRow("empty object") << QStringLiteral("{}") << false;
+    QTest::newRow("empty") << QString() << false;
+    QTest::newRow("array") << QStringLiteral("[{\"subscribe\":true}]") << false;
+}
+
+void tst_CallFlags::isSubscriptionPayload()
+{
+    QFETCH(QString, payload);
+    QFETCH(bool, subscription);
+
+    QCOMPARE(LunaServiceManager::isSubscriptionPayload(payload), subscription);
+}
+
+// A DB8 put of the given number of records, the subscribe flag last
+static QString putPayload(int records)
+{
+    QString payload = QStringLiteral("{\"objects\":[");
+    for (int i = 0; i < records; ++i) {
+        if (i)
+            payload += QLatin1Char(',');
+        payload += QStringLiteral("{\"_kind\":\"com.webos.test:1\",\"id\":%1,\"name\":\"record %1\",\"tags\":[\"a\",\"b\"]}").arg(i);
+    }
+    payload += QStringLiteral("],\"subscribe\":true}");
+    return payload;
+}
+
+static void addPayloads()
+{
+    QTest::addColumn<QString>("payload");
+
+    for (int records : {1, 100, 10000}) {
+        const QString payload = putPayload(records);
+        QTest::newRow(qPrintable(QStringLiteral("%1 bytes").arg(payload.size()))) << payload;
+    }
+}
+
+void tst_CallFlags::scanPayload_data()
+{
+    addPayloads();
+}
+
+void tst_CallFlags::scanPayload()
+{
+    QFETCH(QString, payload);
+
+    bool subscription = false;
+    QBENCHMARK {
+        subscription = LunaServiceManager::isSubscriptionPayload(payload);
+    }
+    QVERIFY(subscription);
+}
+
+void tst_CallFlags::parsePayload_data()
+{
+    addPayloads();
+}
+
+// What a call cost before the scanner, for comparison
+void tst_CallFlags::parsePayload()
+{
+    QFETCH(QString, payload);
+
+    bool subscription = false;
+    QBENCHMARK {
+        const QJsonObject object = QJsonDocument::fromJson(payload.toUtf8()).object();
+        subscription = object.value(QLatin1String("subscribe")).toBool();
+    }
+    QVERIFY(subscription);
+}
+
+QTEST_GUILESS_MAIN(tst_CallFlags)
+
+#include "tst_callflags.moc"
@@ -0,0 +1,233 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <random>
+
+#include <QHash>
+#include <QtTest>
+
+#include "calltable.h"
+#include "lunaservicemgr.h"
+
+class Listener : public LunaServiceManagerListener
+{
+public:
+    Listener() : LunaServiceManagerListener(nullptr) {}
+
+    void serviceResponse(const QString&, const LunaServiceReply&, int) override {}
+    void hubError(const QString&, const QString&, const LunaServiceReply&, int) override {}
+};
+
+// Only compared, never used as a handle
+static LSHandle *fakeHandle(quintptr id)
+{
+    return reinterpret_cast<LSHandle *>(id * 16);
+}
+
+static quint32 insertCall(LSHandle *handle, LSMessageToken token, Listener *listener, bool subscription = false)
+{
+    CallTable::Slot call;
+    call.token = token;
+    call.handle = handle;
+    call.listener = listener;
+    call.generation = CallTable::instance()->nextGeneration();
+    call.subscription = subscription;
+    CallTable::instance()->insert(call);
+    return call.generation;
+}
+
+class tst_CallTable : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void init();
+    void insertFindRemove();
+    void handleIsPartOfTheKey();
+    void findByListener();
+    void backwardShift();
+    void takeAll();
+
+    void dispatch10k();
+    void churn10k();
+};
+
+void tst_CallTable::init()
+{
+    // Every test leaves the table as it found it
+    QCOMPARE(CallTable::instance()->size(), 0);
+}
+
+void tst_CallTable::insertFindRemove()
+{
+    CallTable *table = CallTable::instance();
+    Listener listener;
+    LSHandle *handle = fakeHandle(1);
+
+    const quint32 generation = insertCall(handle, 7, &listener, true);
+    QCOMPARE(table->size(), 1);
+
+    const CallTable::Slot *slot = table->find(handle, 7);
+    QVERIFY(slot);
+    QCOMPARE(slot->listener, static_cast<LunaServiceManagerListener *>(&listener));
+    QCOMPARE(slot->generation, generation);
+    QVERIFY(slot->subscription);
+    QVERIFY(!table->find(handle, 8));
+    QVERIFY(!table->find(handle, LSMESSAGE_TOKEN_INVALID));
+
+    // Inserting the same call again replaces it
+    const quint32 replaced = insertCall(handle, 7, &listener);
+    QCOMPARE(table->size(), 1);
+    QCOMPARE(table->find(handle, 7)->generation, replaced);
+
+    QVERIFY(table->remove(handle, 7));
+    QVERIFY(!table->remove(handle, 7));
+    QVERIFY(!table->find(handle, 7));
+    QCOMPARE(table->size(), 0);
+}
+
+void tst_CallTable::handleIsPartOfTheKey()
+{
+    CallTable *table = CallTable::instance();
+    Listener first;
+    Listener second;
+
+    insertCall(fakeHandle(1), 5, &first);
+    insertCall(fakeHandle(2), 5, &second);
+    QCOMPARE(table->size(), 2);
+
+    QCOMPARE(table->find(fakeHandle(1), 5)->listener, static_cast<LunaServiceManagerListener *>(&first));
+    QCOMPARE(table->find(fakeHandle(2), 5)->listener, static_cast<LunaServiceManagerListener *>(&second));
+
+    QVERIFY(table->remove(fakeHandle(1), 5));
+    QVERIFY(!table->find(fakeHandle(1), 5));
+    QVERIFY(table->find(fakeHandle(2), 5));
+    QVERIFY(table->remove(fakeHandle(2), 5));
+}
+
+void tst_CallTable::findByListener()
+{
+    Listener first;
+    Listener second;
+
+    insertCall(fakeHandle(1), 11, &first, true);
+    QVERIFY(first.isSubscription(11));
+    QVERIFY(!second.isSubscription(11));
+    QVERIFY(!CallTable::instance()->find(static_cast<const LunaServiceManagerListener *>(&second), 11));
+
+    QVERIFY(CallTable::instance()->remove(fakeHandle(1), 11));
+    QVERIFY(!first.isSubscription(11));
+}
+
+void tst_CallTable::backwardShift()
+{
+    // Random inserts and removals of dense tokens, so that probe sequences
+    // overlap and wrap, checked against a QHash after every step
+    CallTable *table = CallTable::instance();
+    Listener listener;
+    LSHandle *handle = fakeHandle(1);
+
+    std::mt19937 generator(20260101);
+    std::uniform_int_distribution<int> tokens(1, 500);
+    QHash<LSMessageToken, quint32> expected;
+
+    for (int step = 0; step < 20000; ++step) {
+        const LSMessageToken token = tokens(generator);
+        if (generator() % 2)
+            expected.insert(token, insertCall(handle, token, &listener));
+        else
+            QCOMPARE(table->remove(handle, token), expected.remove(token) == 1);
+
+        if (step % 50)
+            continue;
+        QCOMPARE(table->size(), expected.size());
+        for (LSMessageToken t = 1; t <= 500; ++t) {
+            const CallTable::Slot *slot = table->find(handle, t);
+            QCOMPARE(slot != nullptr, expected.contains(t));
+            if (slot)
+                QCOMPARE(slot->generation, expected.value(t));
+        }
+    }
+
+    for (auto it = expected.constBegin(); it != expected.constEnd(); ++it)
+        QVERIFY(table->remove(handle, it.key()));
+    QCOMPARE(table->size(), 0);
+}
+
+void tst_CallTable::takeAll()
+{
+    CallTable *table = CallTable::instance();
+    Listener first;
+    Listener second;
+
+    for (LSMessageToken token = 1; token <= 200; ++token)
+        insertCall(fakeHandle(1), token, token % 3 ? &first : &second);
+
+    const QVector<CallTable::Slot> taken = table->takeAll(&first);
+    QCOMPARE(taken.size(), 134);
+    for (const CallTable::Slot &slot : taken)
+        QCOMPARE(slot.listener, static_cast<LunaServiceManagerListener *>(&first));
+
+    QCOMPARE(table->size(), 66);
+    for (LSMessageToken token = 1; token <= 200; ++token)
+        QCOMPARE(table->find(fakeHandle(1), token) != nullptr, token % 3 == 0);
+
+    QVERIFY(table->takeAll(&first).isEmpty());
+    // The rest goes with its listener
+}
+
+void tst_CallTable::dispatch10k()
+{
+    CallTable *table = CallTable::instance();
+    Listener listener;
+    LSHandle *handle = fakeHandle(1);
+
+    for (LSMessageToken token = 1; token <= 10000; ++token)
+        insertCall(handle, token, &listener, true);
+
+    // The lookup of a subscription reply with 10k calls outstanding
+    quint32 sum = 0;
+    QBENCHMARK {
+        for (LSMessageToken token = 1; token <= 10000; ++token)
+            sum += table->find(handle, token)->generation;
+    }
+    QVERIFY(sum);
+}
+
+void tst_CallTable::churn10k()
+{
+    CallTable *table = CallTable::instance();
+    Listener listener;
+    LSHandle *handle = fakeHandle(1);
+
+    for (LSMessageToken token = 1; token <= 10000; ++token)
+        insertCall(handle, token, &listener);
+
+    // One-reply calls answered and issued again, 10k outstanding throughout
+    LSMessageToken next = 10001;
+    QBENCHMARK {
+        for (int i = 0; i < 10000; ++i) {
+            table->remove(handle, next - 10000);
+            insertCall(handle, next++, &listener);
+        }
+    }
+    QCOMPARE(table->size(), 10000);
+}
+
+QTEST_GUILESS_MAIN(tst_CallTable)
+
+#include "tst_calltable.moc"
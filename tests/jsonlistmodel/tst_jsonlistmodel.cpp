@@ -0,0 +1,212 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <algorithm>
+#include <random>
+
+#include <QAbstractItemModelTester>
+#include <QRegularExpression>
+#include <QSignalSpy>
+#include <QtTest>
+
+#include "jsonlistmodel.h"
+
+class TestModel : public JsonListModel
+{
+public:
+    TestModel() : JsonListModel(QStringLiteral("id")) {}
+
+    using JsonListModel::setRows;
+};
+
+static QJsonObject row(const QString& id, int value = 0)
+{
+    QJsonObject object;
+    object.insert(QStringLiteral("id"), id);
+    object.insert(QStringLiteral("value"), value);
+    return object;
+}
+
+// One row per character, e.g. "abc"
+static QVector<QJsonObject> rows(const QString& ids)
+{
+    QVector<QJsonObject> result;
+    for (const QChar &id : ids)
+        result.append(row(QString(id)));
+    return result;
+}
+
+static QString ids(const JsonListModel& model)
+{
+    QString result;
+    for (int i = 0; i < model.count(); ++i)
+        result += model.get(i).value(QStringLiteral("id")).toString();
+    return result;
+}
+
+class tst_JsonListModel : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void fill();
+    void sameRows();
+    void singleMove();
+    void removeAndInsert();
+    void updateOnly();
+    void dropsInvalidRows();
+    void randomLists();
+};
+
+void tst_JsonListModel::fill()
+{
+    TestModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy count(&model, &JsonListModel::countChanged);
+
+    model.setRows(rows(QStringLiteral("abc")));
+
+    QCOMPARE(ids(model), QStringLiteral("abc"));
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(count.count(), 1);
+    QCOMPARE(model.indexOf(QStringLiteral("c")), 2);
+    QCOMPARE(model.indexOf(QStringLiteral("d")), -1);
+    QVERIFY(model.roleNames().values().contains("value"));
+}
+
+void tst_JsonListModel::sameRows()
+{
+    TestModel model;
+    model.setRows(rows(QStringLiteral("abc")));
+
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy count(&model, &JsonListModel::countChanged);
+
+    model.setRows(rows(QStringLiteral("abc")));
+
+    QCOMPARE(inserted.count() + removed.count() + moved.count() + changed.count() + count.count(), 0);
+}
+
+void tst_JsonListModel::singleMove()
+{
+    TestModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.setRows(rows(QStringLiteral("abcdef")));
+
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+
+    // One row moved is one move, not a shift of the rows in between
+    model.setRows(rows(QStringLiteral("fabcde")));
+
+    QCOMPARE(ids(model), QStringLiteral("fabcde"));
+    QCOMPARE(moved.count(), 1);
+    QCOMPARE(inserted.count(), 0);
+    QCOMPARE(removed.count(), 0);
+    for (int i = 0; i < model.count(); ++i)
+        QCOMPARE(model.indexOf(ids(model).mid(i, 1)), i);
+}
+
+void tst_JsonListModel::removeAndInsert()
+{
+    TestModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+    model.setRows(rows(QStringLiteral("abcdef")));
+
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy moved(&model, &QAbstractItemModel::rowsMoved);
+
+    model.setRows(rows(QStringLiteral("axyef")));
+
+    QCOMPARE(ids(model), QStringLiteral("axyef"));
+    // A run of rows at once
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(moved.count(), 0);
+}
+
+void tst_JsonListModel::updateOnly()
+{
+    TestModel model;
+    model.setRows(rows(QStringLiteral("abc")));
+
+    QSignalSpy changed(&model, &QAbstractItemModel::dataChanged);
+    QSignalSpy inserted(&model, &QAbstractItemModel::rowsInserted);
+    QSignalSpy removed(&model, &QAbstractItemModel::rowsRemoved);
+
+    QVector<QJsonObject> updated = rows(QStringLiteral("abc"));
+    updated[1] = row(QStringLiteral("b"), 1);
+    model.setRows(updated);
+
+    QCOMPARE(inserted.count() + removed.count(), 0);
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(changed.at(0).at(0).value<QModelIndex>().row(), 1);
+    QCOMPARE(model.get(1).value(QStringLiteral("value")).toInt(), 1);
+}
+
+void tst_JsonListModel::dropsInvalidRows()
+{
+    TestModel model;
+
+    QVector<QJsonObject> input = rows(QStringLiteral("aba"));
+    input.append(QJsonObject());
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Dropping")));
+    QTest::ignoreMessage(QtWarningMsg, QRegularExpression(QStringLiteral("Dropping")));
+    model.setRows(input);
+
+    QCOMPARE(ids(model), QStringLiteral("ab"));
+}
+
+void tst_JsonListModel::randomLists()
+{
+    // Any list to any other, checked by the model tester on the way and
+    // against the target at the end
+    TestModel model;
+    QAbstractItemModelTester tester(&model, QAbstractItemModelTester::FailureReportingMode::QtTest);
+
+    std::mt19937 generator(20260101);
+    QVector<QString> pool;
+    for (int i = 0; i < 30; ++i)
+        pool.append(QString::number(i));
+
+    for (int round = 0; round < 300; ++round) {
+        std::shuffle(pool.begin(), pool.end(), generator);
+        const int size = generator() % (pool.size() + 1);
+
+        QVector<QJsonObject> target;
+        for (int i = 0; i < size; ++i)
+            target.append(row(pool.at(i), generator() % 3));
+
+        model.setRows(target);
+
+        QCOMPARE(model.count(), target.size());
+        for (int i = 0; i < target.size(); ++i) {
+            QCOMPARE(model.get(i), target.at(i).toVariantMap());
+            QCOMPARE(model.indexOf(target.at(i).value(QStringLiteral("id")).toString()), i);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(tst_JsonListModel)
+
+#include "tst_jsonlistmodel.moc"
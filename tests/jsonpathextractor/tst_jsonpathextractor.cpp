@@ -0,0 +1,220 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QtTest>
+
+#include "jsonpathextractor.h"
+
+static const QStringList s_localePaths = {
+    QStringLiteral("settings.localeInfo.locales.UI"),
+    QStringLiteral("settings.localeInfo.locales.STT"),
+    QStringLiteral("screenRotation")
+};
+
+class tst_JsonPathExtractor : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void sameAsDocument_data();
+    void sameAsDocument();
+    void values();
+    void pathBelowPath();
+    void escapedKey();
+    void invalid_data();
+    void invalid();
+
+    void extract_data();
+    void extract();
+    void parseDocument_data();
+    void parseDocument();
+};
+
+void tst_JsonPathExtractor::sameAsDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("settings") << QByteArray(
+        "{\"returnValue\":true,\"method\":\"getSystemSettings\",\"settings\":{\"localeInfo\":"
+        "{\"keyboards\":[\"en\"],\"locales\":{\"UI\":\"en-US\",\"FMT\":\"en-US\",\"STT\":\"ko-KR\"}}},"
+        "\"screenRotation\":\"off\"}");
+    QTest::newRow("skipped values") << QByteArray(
+        "{\"a\":\"}{][\\\"\",\"b\":[{\"settings\":1},\"]\"],\"c\":{\"d\":{\"e\":[1,2,{\"f\":\"}\"}]}},"
+        "\"settings\":{\"localeInfo\":{\"locales\":{\"UI\":\"de-DE\"}}}}");
+    QTest::newRow("spaces") << QByteArray(
+        " {\n \"screenRotation\" :\t\"90\" ,\r\n \"settings\" : { \"localeInfo\" : { \"locales\" : { \"STT\" : \"en-GB\" } } } } ");
+    QTest::newRow("missing") << QByteArray("{\"settings\":{\"other\":true},\"x\":null}");
+    QTest::newRow("not an object") << QByteArray("{\"settings\":{\"localeInfo\":[1,2]},\"screenRotation\":12.5}");
+    QTest::newRow("empty") << QByteArray("{}");
+}
+
+void tst_JsonPathExtractor::sameAsDocument()
+{
+    QFETCH(QByteArray, json);
+
+    const JsonPathExtractor extractor(s_localePaths);
+    bool ok = false;
+    const QVector<QJsonValue> values = extractor.extract(json, &ok);
+
+    QVERIFY(ok);
+    QCOMPARE(values, extractor.extract(QJsonDocument::fromJson(json).object()));
+}
+
+void tst_JsonPathExtractor::values()
+{
+    const JsonPathExtractor extractor({
+        QStringLiteral("string"), QStringLiteral("number"), QStringLiteral("yes"),
+        QStringLiteral("no"), QStringLiteral("nothing"), QStringLiteral("list"),
+        QStringLiteral("object"), QStringLiteral("missing")
+    });
+    const QByteArray json(
+        "{\"string\":\"a\\\"b\\\\c\\nd\\u00e9\\ud83d\\ude00\",\"number\":-1.5e3,\"yes\":true,\"no\":false,"
+        "\"nothing\":null,\"list\":[1,\"x\",{\"y\":[]}],\"object\":{\"z\":{}}}");
+
+    bool ok = false;
+    const QVector<QJsonValue> values = extractor.extract(json, &ok);
+
+    QVERIFY(ok);
+    QCOMPARE(values.size(), 8);
+    QCOMPARE(values, extractor.extract(QJsonDocument::fromJson(json).object()));
+    QCOMPARE(values.at(0).toString(), QString::fromUtf8("a\"b\\c\nd\xc3\xa9\xf0\x9f\x98\x80"));
+    QCOMPARE(values.at(1).toDouble(), -1500.0);
+    QVERIFY(values.at(4).isNull());
+    QVERIFY(values.at(7).isUndefined());
+}
+
+void tst_JsonPathExtractor::pathBelowPath()
+{
+    const JsonPathExtractor extractor({QStringLiteral("a.b"), QStringLiteral("a")});
+    const QByteArray json("{\"a\":{\"b\":2,\"c\":3}}");
+
+    const QVector<QJsonValue> values = extractor.extract(json);
+
+    QCOMPARE(values.at(0), QJsonValue(2));
+    QVERIFY(values.at(1).isObject());
+    QCOMPARE(values.at(1).toObject().value(QStringLiteral("c")), QJsonValue(3));
+}
+
+void tst_JsonPathExtractor::escapedKey()
+{
+    const JsonPathExtractor extractor({QStringLiteral("locale")});
+
+    QCOMPARE(extractor.extract(QByteArray("{\"lo\\u0063ale\":\"x\"}")).at(0), QJsonValue(QStringLiteral("x")));
+}
+
+void tst_JsonPathExtractor::invalid_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("empty") << QByteArray();
+    QTest::newRow("array") << QByteArray("[{\"screenRotation\":\"off\"}]");
+    QTest::newRow("truncated") << QByteArray("{\"settings\":{\"localeInfo\":");
+    QTest::newRow("unterminated string") << QByteArray("{\"a\":\"b");
+    QTest::newRow("missing colon") << QByteArray("{\"screenRotation\" \"off\"}");
+    QTest::newRow("bad literal") << QByteArray("{\"screenRotation\":nope}");
+}
+
+void tst_JsonPathExtractor::invalid()
+{
+    QFETCH(QByteArray, json);
+
+    const JsonPathExtractor extractor(s_localePaths);
+    bool ok = true;
+    extractor.extract(json, &ok);
+
+    QVERIFY(!ok);
+}
+
+// getSystemSettings with a lot of categories, the locales in the middle
+static QByteArray settingsPayload(int members)
+{
+    QJsonObject settings;
+    for (int i = 0; i < members; ++i) {
+        QJsonObject member;
+        member.insert(QStringLiteral("value"), i);
+        member.insert(QStringLiteral("label"), QStringLiteral("setting number %1").arg(i));
+        member.insert(QStringLiteral("options"), QJsonArray({1, 2, 3}));
+        // The keys are sorted, localeInfo falls between the halves
+        settings.insert(QString::fromLatin1(i < members / 2 ? "k%1" : "n%1").arg(i), member);
+    }
+    QJsonObject locales;
+    locales.insert(QStringLiteral("UI"), QStringLiteral("en-US"));
+    locales.insert(QStringLiteral("STT"), QStringLiteral("en-US"));
+    QJsonObject localeInfo;
+    localeInfo.insert(QStringLiteral("locales"), locales);
+    settings.insert(QStringLiteral("localeInfo"), localeInfo);
+
+    QJsonObject root;
+    root.insert(QStringLiteral("returnValue"), true);
+    root.insert(QStringLiteral("settings"), settings);
+    root.insert(QStringLiteral("screenRotation"), QStringLiteral("off"));
+    return QJsonDocument(root).toJson(QJsonDocument::Compact);
+}
+
+static void addPayloads()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    for (int members : {10, 1000}) {
+        const QByteArray json = settingsPayload(members);
+        QTest::newRow(qPrintable(QStringLiteral("%1 bytes").arg(json.size()))) << json;
+    }
+}
+
+void tst_JsonPathExtractor::extract_data()
+{
+    addPayloads();
+}
+
+void tst_JsonPathExtractor::extract()
+{
+    QFETCH(QByteArray, json);
+
+    const JsonPathExtractor extractor(s_localePaths);
+    QVector<QJsonValue> values;
+    QBENCHMARK {
+        values = extractor.extract(json);
+    }
+    QCOMPARE(values.at(0).toString(), QStringLiteral("en-US"));
+}
+
+void tst_JsonPathExtractor::parseDocument_data()
+{
+    addPayloads();
+}
+
+// The same values out of the whole document, as before the extractor
+void tst_JsonPathExtractor::parseDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QString ui;
+    QBENCHMARK {
+        const QJsonObject root = QJsonDocument::fromJson(json).object();
+        const QJsonObject locales = root.value(QStringLiteral("settings")).toObject()
+                .value(QStringLiteral("localeInfo")).toObject()
+                .value(QStringLiteral("locales")).toObject();
+        ui = locales.value(QStringLiteral("UI")).toString();
+    }
+    QCOMPARE(ui, QStringLiteral("en-US"));
+}
+
+QTEST_APPLESS_MAIN(tst_JsonPathExtractor)
+
+#include "tst_jsonpathextractor.moc"
@@ -0,0 +1,864 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include "lunaservicestub.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <glib.h>
+
+// Sent instead of a reply when LSCallSetTimeout expires
+static const char strTimeout[] = "Timeout";
+
+struct LSMessage
+{
+    std::atomic<int> ref;
+    // Handle the message is delivered to
+    LSHandle *connection;
+    std::string method;
+    std::string payload;
+    std::string sender;
+    std::string appId;
+    std::string sessionId;
+    LSMessageToken token;
+    bool hubError;
+    bool subscription;
+};
+
+struct LSHandle
+{
+    std::string name;
+    std::string appId;
+    GMainContext *context;
+    int priority;
+
+    // Run in order from the context by a single idle source
+    std::deque<std::function<void ()>> jobs;
+    GSource *flush;
+
+    // Category -> method -> function
+    std::map<std::string, std::map<std::string, LSMethodFunction>> methods;
+    std::map<std::string, void *> categoryData;
+    LSFilterFunc cancelFunction;
+    void *cancelContext;
+    // Subscription key -> requests
+    std::map<std::string, std::vector<LSMessage *>> subscriptions;
+};
+
+namespace {
+
+struct Pending
+{
+    LSHandle *handle;
+    LSFilterFunc callback;
+    void *context;
+    bool oneReply;
+    bool answered;
+    std::string uri;
+    std::string method;
+    std::string service;
+
+    GSource *timeout;
+
+    // Replies left to send from the script, -1 for no limit
+    GSource *feed;
+    LunaServiceStub::Script script;
+    int sent;
+    gint64 start;
+
+    // Request of a loopback call, until answered or cancelled
+    LSMessage *request;
+    std::vector<std::pair<LSHandle *, std::string>> subscribedAt;
+};
+
+struct State
+{
+    std::mutex mutex;
+    std::map<std::string, LSHandle *> handles;
+    std::set<LSHandle *> live;
+    std::map<LSMessageToken, Pending> pending;
+    std::map<std::string, LunaServiceStub::Script> scripts;
+    LunaServiceStub::Responder responder;
+    LSMessageToken nextToken = 1;
+};
+
+State &state()
+{
+    static State *s_state = new State;
+    return *s_state;
+}
+
+#define setError(lserror, text) fillError((lserror), (text), __FILE__, __LINE__, __func__)
+
+bool fillError(LSError *lserror, const char *text, const char *file, int line, const char *func)
+{
+    if (lserror) {
+        lserror->error_code = -1;
+        lserror->message = g_strdup(text);
+        lserror->file = file;
+        lserror->line = line;
+        lserror->func = func;
+    }
+    return false;
+}
+
+LSMessage *newMessage(LSHandle *connection, LSMessageToken token, const std::string& method,
+                      const std::string& payload, bool hubError)
+{
+    LSMessage *message = new LSMessage;
+    message->ref = 1;
+    message->connection = connection;
+    message->method = method;
+    message->payload = payload;
+    message->token = token;
+    message->hubError = hubError;
+    message->subscription = false;
+    return message;
+}
+
+// "subscribe": true anywhere in the payload, as the hub would see it
+bool isSubscription(const std::string& payload)
+{
+    static const char key[] = "\"subscribe\"";
+    size_t i = payload.find(key);
+    if (i == std::string::npos)
+        return false;
+
+    i += sizeof(key) - 1;
+    while (i < payload.size() && (payload[i] == ' ' || payload[i] == ':' || payload[i] == '\t'
+                                  || payload[i] == '\n' || payload[i] == '\r'))
+        ++i;
+    return payload.compare(i, 4, "true") == 0;
+}
+
+std::string hubErrorPayload(const std::string& error)
+{
+    return "{\"returnValue\":false,\"errorCode\":-1,\"errorText\":\"" + error + "\"}";
+}
+
+gboolean flushJobs(gpointer data)
+{
+    LSHandle *handle = static_cast<LSHandle *>(data);
+    std::deque<std::function<void ()>> jobs;
+    {
+        std::lock_guard<std::mutex> locker(state().mutex);
+        jobs.swap(handle->jobs);
+        g_source_unref(handle->flush);
+        handle->flush = nullptr;
+    }
+
+    for (const std::function<void ()>& job : jobs)
+        job();
+    return G_SOURCE_REMOVE;
+}
+
+// Called with the lock held
+void scheduleFlush(LSHandle *handle)
+{
+    if (handle->flush || !handle->context || handle->jobs.empty())
+        return;
+
+    handle->flush = g_idle_source_new();
+    g_source_set_priority(handle->flush, handle->priority);
+    g_source_set_callback(handle->flush, flushJobs, handle, nullptr);
+    g_source_attach(handle->flush, handle->context);
+}
+
+// Called with the lock held
+void post(LSHandle *handle, std::function<void ()> job)
+{
+    handle->jobs.push_back(std::move(job));
+    scheduleFlush(handle);
+}
+
+// Called with the lock held
+void destroySource(GSource *&source)
+{
+    if (source) {
+        g_source_destroy(source);
+        g_source_unref(source);
+        source = nullptr;
+    }
+}
+
+// Called with the lock held. Drops the loopback request and the
+// subscriptions made with it, the cancel functions are run later.
+void releaseRequest(Pending& call)
+{
+    if (!call.request)
+        return;
+
+    LSMessage *request = call.request;
+    call.request = nullptr;
+
+    for (const std::pair<LSHandle *, std::string>& at : call.subscribedAt) {
+        LSHandle *provider = at.first;
+        if (!state().live.count(provider))
+            continue;
+
+        std::map<std::string, std::vector<LSMessage *>>::iterator it = provider->subscriptions.find(at.second);
+        if (it == provider->subscriptions.end())
+            continue;
+
+        std::vector<LSMessage *>& subscribers = it->second;
+        for (std::vector<LSMessage *>::iterator s = subscribers.begin(); s != subscribers.end(); ++s) {
+            if (*s == request) {
+                subscribers.erase(s);
+                if (subscribers.empty())
+                    provider->subscriptions.erase(it);
+
+                LSFilterFunc cancel = provider->cancelFunction;
+                void *context = provider->cancelContext;
+                post(provider, [provider, request, cancel, context]() {
+                    if (cancel)
+                        cancel(provider, request, context);
+                    LSMessageUnref(request);
+                });
+                break;
+            }
+        }
+    }
+    call.subscribedAt.clear();
+
+    LSMessageUnref(request);
+}
+
+// Called with the lock held
+void endCall(std::map<LSMessageToken, Pending>::iterator it)
+{
+    destroySource(it->second.timeout);
+    destroySource(it->second.feed);
+    releaseRequest(it->second);
+    state().pending.erase(it);
+}
+
+// Runs on the context of the caller
+void deliver(LSMessageToken token, const std::string& method, const std::string& payload, bool hubError)
+{
+    LSHandle *handle;
+    LSFilterFunc callback;
+    void *context;
+    std::string service;
+    {
+        std::lock_guard<std::mutex> locker(state().mutex);
+        std::map<LSMessageToken, Pending>::iterator it = state().pending.find(token);
+        if (it == state().pending.end())
+            return;
+
+        Pending& call = it->second;
+        handle = call.handle;
+        callback = call.callback;
+        context = call.context;
+        service = call.service;
+        call.answered = true;
+        destroySource(call.timeout);
+
+        if (call.oneReply || hubError)
+            endCall(it);
+    }
+
+    if (!callback)
+        return;
+
+    LSMessage *message = newMessage(handle, token, method, payload, hubError);
+    message->sender = service;
+    callback(handle, message, context);
+    LSMessageUnref(message);
+}
+
+// Called with the lock held
+bool postReply(LSMessageToken token, const std::string& payload, bool hubError)
+{
+    std::map<LSMessageToken, Pending>::iterator it = state().pending.find(token);
+    if (it == state().pending.end())
+        return false;
+
+    const std::string method = hubError ? payload : it->second.method;
+    const std::string body = hubError ? hubErrorPayload(payload) : payload;
+    post(it->second.handle, [token, method, body, hubError]() {
+        deliver(token, method, body, hubError);
+    });
+    return true;
+}
+
+gboolean feedScript(gpointer data)
+{
+    const LSMessageToken token = static_cast<LSMessageToken>(reinterpret_cast<uintptr_t>(data));
+    std::string method;
+    std::string payload;
+    int due;
+    bool done;
+    {
+        std::lock_guard<std::mutex> locker(state().mutex);
+        std::map<LSMessageToken, Pending>::iterator it = state().pending.find(token);
+        if (it == state().pending.end())
+            return G_SOURCE_REMOVE;
+
+        Pending& call = it->second;
+        const gint64 now = g_get_monotonic_time();
+        if (now < call.start)
+            return G_SOURCE_CONTINUE;
+
+        const LunaServiceStub::Script& script = call.script;
+        int target = script.rate > 0 ? 1 + static_cast<int>((now - call.start) * script.rate / G_USEC_PER_SEC)
+                                     : call.sent + 1;
+        const int limit = call.oneReply ? 1 : script.replies;
+        if (limit >= 0 && target > limit)
+            target = limit;
+
+        due = target - call.sent;
+        call.sent = target;
+        done = limit >= 0 && call.sent >= limit;
+        if (done && call.feed) {
+            // Returning G_SOURCE_REMOVE destroys it
+            g_source_unref(call.feed);
+            call.feed = nullptr;
+        }
+
+        method = call.method;
+        payload = script.payload;
+    }
+
+    for (int i = 0; i < due; ++i)
+        deliver(token, method, payload, false);
+
+    return done ? G_SOURCE_REMOVE : G_SOURCE_CONTINUE;
+}
+
+gboolean expire(gpointer data)
+{
+    const LSMessageToken token = static_cast<LSMessageToken>(reinterpret_cast<uintptr_t>(data));
+    {
+        std::lock_guard<std::mutex> locker(state().mutex);
+        std::map<LSMessageToken, Pending>::iterator it = state().pending.find(token);
+        if (it == state().pending.end() || it->second.timeout == nullptr)
+            return G_SOURCE_REMOVE;
+
+        g_source_unref(it->second.timeout);
+        it->second.timeout = nullptr;
+    }
+
+    deliver(token, strTimeout, hubErrorPayload(strTimeout), true);
+    return G_SOURCE_REMOVE;
+}
+
+// Called with the lock held
+void startFeed(LSMessageToken token, Pending& call, const LunaServiceStub::Script& script)
+{
+    call.script = script;
+    call.sent = 0;
+    call.start = g_get_monotonic_time() + script.delay;
+
+    if (script.rate > 0)
+        call.feed = g_timeout_source_new(std::max(1, static_cast<int>(1000 / script.rate)));
+    else if (script.delay > 0)
+        call.feed = g_timeout_source_new(std::max(1, script.delay / 1000));
+    else
+        call.feed = g_idle_source_new();
+
+    g_source_set_priority(call.feed, call.handle->priority);
+    g_source_set_callback(call.feed, feedScript, reinterpret_cast<gpointer>(static_cast<uintptr_t>(token)), nullptr);
+    g_source_attach(call.feed, call.handle->context);
+}
+
+// Runs on the context of the provider
+void dispatchRequest(LSHandle *provider, LSMessage *request, const std::string& category)
+{
+    LSMethodFunction function = nullptr;
+    void *data = nullptr;
+    {
+        std::lock_guard<std::mutex> locker(state().mutex);
+        std::map<std::string, std::map<std::string, LSMethodFunction>>::const_iterator c = provider->methods.find(category);
+        if (c != provider->methods.end()) {
+            std::map<std::string, LSMethodFunction>::const_iterator m = c->second.find(request->method);
+            if (m != c->second.end())
+                function = m->second;
+        }
+        data = provider->categoryData[category];
+
+        if (!function)
+            postReply(request->token, LUNABUS_ERROR_UNKNOWN_METHOD, true);
+    }
+
+    if (function)
+        function(provider, request, data);
+    LSMessageUnref(request);
+}
+
+bool call(LSHandle *sh, const char *uri, const char *payload, const char *sessionId, const char *appId,
+          LSFilterFunc callback, void *context, bool oneReply, LSMessageToken *token, LSError *lserror)
+{
+    if (!sh || !uri || !payload)
+        return setError(lserror, "Invalid arguments");
+
+    // luna://service/category/method
+    const std::string address(uri);
+    static const std::string scheme("luna://");
+    const size_t serviceStart = address.compare(0, scheme.size(), scheme) == 0 ? scheme.size() : 0;
+    const size_t serviceEnd = address.find('/', serviceStart);
+    const size_t methodStart = address.rfind('/');
+    if (serviceEnd == std::string::npos || methodStart + 1 >= address.size())
+        return setError(lserror, "Invalid URI");
+
+    const std::string service = address.substr(serviceStart, serviceEnd - serviceStart);
+    const std::string method = address.substr(methodStart + 1);
+    const std::string category = methodStart > serviceEnd ? address.substr(serviceEnd, methodStart - serviceEnd) : "/";
+
+    LunaServiceStub::Call responderCall;
+    LunaServiceStub::Responder responder;
+    {
+        std::lock_guard<std::mutex> locker(state().mutex);
+        if (!state().live.count(sh))
+            return setError(lserror, "Invalid handle");
+
+        LSMessageToken callToken = state().nextToken++;
+        Pending& call = state().pending[callToken];
+        call.handle = sh;
+        call.callback = callback;
+        call.context = context;
+        call.oneReply = oneReply;
+        call.answered = false;
+        call.uri = address;
+        call.method = method;
+        call.service = service;
+        call.timeout = nullptr;
+        call.feed = nullptr;
+        call.sent = 0;
+        call.start = 0;
+        call.request = nullptr;
+        if (token)
+            *token = callToken;
+
+        std::map<std::string, LSHandle *>::const_iterator registered = state().handles.find(service);
+        LSHandle *provider = registered != state().handles.end() ? registered->second : nullptr;
+        std::map<std::string, LunaServiceStub::Script>::const_iterator script = state().scripts.find(address);
+
+        if (provider) {
+            LSMessage *request = newMessage(provider, callToken, method, payload, false);
+            request->sender = sh->name;
+            request->appId = appId ? appId : sh->appId;
+            request->sessionId = sessionId ? sessionId : "";
+            request->subscription = !oneReply && isSubscription(request->payload);
+            LSMessageRef(request);
+            call.request = request;
+            post(provider, [provider, request, category]() {
+                dispatchRequest(provider, request, category);
+            });
+        } else if (script != state().scripts.end() && sh->context) {
+            startFeed(callToken, call, script->second);
+        } else if (state().responder) {
+            responder = state().responder;
+            responderCall.handle = sh;
+            responderCall.token = callToken;
+            responderCall.uri = address;
+            responderCall.payload = payload;
+            responderCall.appId = appId ? appId : "";
+            responderCall.oneReply = oneReply;
+        } else {
+            postReply(callToken, LUNABUS_ERROR_SERVICE_DOWN, true);
+        }
+    }
+
+    if (responder)
+        responder(responderCall);
+    return true;
+}
+
+} // namespace
+
+void LunaServiceStub::setScript(const std::string& uri, const Script& script)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    state().scripts[uri] = script;
+}
+
+void LunaServiceStub::removeScript(const std::string& uri)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    state().scripts.erase(uri);
+}
+
+void LunaServiceStub::setResponder(const Responder& responder)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    state().responder = responder;
+}
+
+bool LunaServiceStub::reply(LSMessageToken token, const std::string& payload)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    return postReply(token, payload, false);
+}
+
+bool LunaServiceStub::hubError(LSMessageToken token, const std::string& error)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    return postReply(token, error, true);
+}
+
+size_t LunaServiceStub::pendingCalls()
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    return state().pending.size();
+}
+
+void LunaServiceStub::reset()
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    state().scripts.clear();
+    state().responder = Responder();
+}
+
+bool LSErrorInit(LSError *lserror)
+{
+    memset(lserror, 0, sizeof(LSError));
+    return true;
+}
+
+void LSErrorFree(LSError *lserror)
+{
+    if (lserror) {
+        g_free(lserror->message);
+        memset(lserror, 0, sizeof(LSError));
+    }
+}
+
+// Set by luna-service2 for the libraries that log through it
+extern "C" void PmLogSetLibContext(PmLogContext context)
+{
+    (void) context;
+}
+
+static bool registerHandle(const char *name, const char *appId, LSHandle **sh, LSError *lserror)
+{
+    if (!sh)
+        return setError(lserror, "Invalid arguments");
+
+    std::lock_guard<std::mutex> locker(state().mutex);
+    const std::string serviceName = name ? name : "";
+    if (!serviceName.empty() && state().handles.count(serviceName))
+        return setError(lserror, "Service name already registered");
+
+    LSHandle *handle = new LSHandle;
+    handle->name = serviceName;
+    handle->appId = appId ? appId : "";
+    handle->context = nullptr;
+    handle->priority = G_PRIORITY_DEFAULT;
+    handle->flush = nullptr;
+    handle->cancelFunction = nullptr;
+    handle->cancelContext = nullptr;
+
+    if (!serviceName.empty())
+        state().handles[serviceName] = handle;
+    state().live.insert(handle);
+    *sh = handle;
+    return true;
+}
+
+bool LSRegister(const char *name, LSHandle **sh, LSError *lserror)
+{
+    return registerHandle(name, nullptr, sh, lserror);
+}
+
+bool LSRegisterApplicationService(const char *name, const char *app_id, LSHandle **sh, LSError *lserror)
+{
+    return registerHandle(name, app_id, sh, lserror);
+}
+
+bool LSUnregister(LSHandle *sh, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.erase(sh))
+        return setError(lserror, "Invalid handle");
+
+    if (!sh->name.empty())
+        state().handles.erase(sh->name);
+
+    std::map<LSMessageToken, Pending>::iterator it = state().pending.begin();
+    while (it != state().pending.end()) {
+        std::map<LSMessageToken, Pending>::iterator next = std::next(it);
+        if (it->second.handle == sh)
+            endCall(it);
+        it = next;
+    }
+
+    for (const std::pair<const std::string, std::vector<LSMessage *>>& key : sh->subscriptions) {
+        for (LSMessage *request : key.second)
+            LSMessageUnref(request);
+    }
+
+    destroySource(sh->flush);
+    if (sh->context)
+        g_main_context_unref(sh->context);
+    delete sh;
+    return true;
+}
+
+bool LSGmainContextAttach(LSHandle *sh, GMainContext *mainContext, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh) || !mainContext)
+        return setError(lserror, "Invalid arguments");
+    if (sh->context)
+        return setError(lserror, "Already attached");
+
+    sh->context = g_main_context_ref(mainContext);
+    scheduleFlush(sh);
+    return true;
+}
+
+bool LSGmainSetPriority(LSHandle *sh, int priority, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh))
+        return setError(lserror, "Invalid handle");
+
+    sh->priority = priority;
+    if (sh->flush)
+        g_source_set_priority(sh->flush, priority);
+    return true;
+}
+
+bool LSRegisterCategoryAppend(LSHandle *sh, const char *category, LSMethod *methodTable,
+                              LSSignal *signalTable, LSError *lserror)
+{
+    (void) signalTable;
+
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh) || !category)
+        return setError(lserror, "Invalid arguments");
+
+    std::map<std::string, LSMethodFunction>& methods = sh->methods[category];
+    for (LSMethod *method = methodTable; method && method->name; ++method)
+        methods[method->name] = method->function;
+    return true;
+}
+
+bool LSCategorySetData(LSHandle *sh, const char *category, void *userData, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh) || !category)
+        return setError(lserror, "Invalid arguments");
+
+    sh->categoryData[category] = userData;
+    return true;
+}
+
+bool LSCall(LSHandle *sh, const char *uri, const char *payload,
+            LSFilterFunc callback, void *ctx, LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, nullptr, nullptr, callback, ctx, false, ret_token, lserror);
+}
+
+bool LSCallOneReply(LSHandle *sh, const char *uri, const char *payload,
+                    LSFilterFunc callback, void *ctx, LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, nullptr, nullptr, callback, ctx, true, ret_token, lserror);
+}
+
+bool LSCallFromApplication(LSHandle *sh, const char *uri, const char *payload, const char *applicationID,
+                           LSFilterFunc callback, void *ctx, LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, nullptr, applicationID, callback, ctx, false, ret_token, lserror);
+}
+
+bool LSCallFromApplicationOneReply(LSHandle *sh, const char *uri, const char *payload, const char *applicationID,
+                                   LSFilterFunc callback, void *ctx, LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, nullptr, applicationID, callback, ctx, true, ret_token, lserror);
+}
+
+#ifdef USE_LUNA_SERVICE2_SESSION_API
+bool LSCallSession(LSHandle *sh, const char *uri, const char *payload, const char *sessionId,
+                   LSFilterFunc callback, void *ctx, LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, sessionId, nullptr, callback, ctx, false, ret_token, lserror);
+}
+
+bool LSCallSessionOneReply(LSHandle *sh, const char *uri, const char *payload, const char *sessionId,
+                           LSFilterFunc callback, void *ctx, LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, sessionId, nullptr, callback, ctx, true, ret_token, lserror);
+}
+
+bool LSCallSessionFromApplication(LSHandle *sh, const char *uri, const char *payload, const char *sessionId,
+                                  const char *applicationID, LSFilterFunc callback, void *ctx,
+                                  LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, sessionId, applicationID, callback, ctx, false, ret_token, lserror);
+}
+
+bool LSCallSessionFromApplicationOneReply(LSHandle *sh, const char *uri, const char *payload, const char *sessionId,
+                                          const char *applicationID, LSFilterFunc callback, void *ctx,
+                                          LSMessageToken *ret_token, LSError *lserror)
+{
+    return call(sh, uri, payload, sessionId, applicationID, callback, ctx, true, ret_token, lserror);
+}
+#endif
+
+bool LSCallCancel(LSHandle *sh, LSMessageToken token, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    std::map<LSMessageToken, Pending>::iterator it = state().pending.find(token);
+    if (it == state().pending.end() || it->second.handle != sh)
+        return setError(lserror, "No such call");
+
+    endCall(it);
+    return true;
+}
+
+bool LSCallSetTimeout(LSHandle *sh, LSMessageToken token, int timeout_ms, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    std::map<LSMessageToken, Pending>::iterator it = state().pending.find(token);
+    if (it == state().pending.end() || it->second.handle != sh || !sh->context)
+        return setError(lserror, "No such call");
+
+    Pending& call = it->second;
+    destroySource(call.timeout);
+    if (call.answered)
+        return true;
+
+    call.timeout = g_timeout_source_new(std::max(0, timeout_ms));
+    g_source_set_priority(call.timeout, sh->priority);
+    g_source_set_callback(call.timeout, expire, reinterpret_cast<gpointer>(static_cast<uintptr_t>(token)), nullptr);
+    g_source_attach(call.timeout, sh->context);
+    return true;
+}
+
+const char *LSMessageGetApplicationID(LSMessage *message)
+{
+    return message->appId.empty() ? nullptr : message->appId.c_str();
+}
+
+const char *LSMessageGetMethod(LSMessage *message)
+{
+    return message->method.c_str();
+}
+
+const char *LSMessageGetPayload(LSMessage *message)
+{
+    return message->payload.c_str();
+}
+
+LSMessageToken LSMessageGetResponseToken(LSMessage *message)
+{
+    return message->token;
+}
+
+const char *LSMessageGetSenderServiceName(LSMessage *message)
+{
+    return message->sender.empty() ? nullptr : message->sender.c_str();
+}
+
+#ifdef USE_LUNA_SERVICE2_SESSION_API
+const char *LSMessageGetSessionId(LSMessage *message)
+{
+    return message->sessionId.empty() ? nullptr : message->sessionId.c_str();
+}
+#endif
+
+bool LSMessageIsHubErrorMessage(LSMessage *message)
+{
+    return message->hubError;
+}
+
+bool LSMessageIsSubscription(LSMessage *message)
+{
+    return message->subscription;
+}
+
+void LSMessageRef(LSMessage *message)
+{
+    message->ref.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LSMessageUnref(LSMessage *message)
+{
+    if (message->ref.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        delete message;
+}
+
+bool LSMessageReply(LSHandle *sh, LSMessage *message, const char *replyPayload, LSError *lserror)
+{
+    if (!sh || !message || !replyPayload)
+        return setError(lserror, "Invalid arguments");
+
+    std::lock_guard<std::mutex> locker(state().mutex);
+    // The caller may be gone, as with a real bus
+    postReply(message->token, replyPayload, false);
+    return true;
+}
+
+bool LSSubscriptionAdd(LSHandle *sh, const char *key, LSMessage *message, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh) || !key || !message)
+        return setError(lserror, "Invalid arguments");
+
+    std::map<LSMessageToken, Pending>::iterator it = state().pending.find(message->token);
+    if (it == state().pending.end() || it->second.request != message)
+        return setError(lserror, "The caller is gone");
+
+    LSMessageRef(message);
+    sh->subscriptions[key].push_back(message);
+    it->second.subscribedAt.push_back(std::make_pair(sh, std::string(key)));
+    return true;
+}
+
+bool LSSubscriptionReply(LSHandle *sh, const char *key, const char *payload, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh) || !key || !payload)
+        return setError(lserror, "Invalid arguments");
+
+    std::map<std::string, std::vector<LSMessage *>>::const_iterator it = sh->subscriptions.find(key);
+    if (it == sh->subscriptions.end())
+        return true;
+
+    for (LSMessage *request : it->second)
+        postReply(request->token, payload, false);
+    return true;
+}
+
+unsigned int LSSubscriptionGetHandleSubscribersCount(LSHandle *sh, const char *key)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    std::map<std::string, std::vector<LSMessage *>>::const_iterator it = sh->subscriptions.find(key);
+    return it == sh->subscriptions.end() ? 0 : it->second.size();
+}
+
+bool LSSubscriptionSetCancelFunction(LSHandle *sh, LSFilterFunc cancelFunction, void *ctx, LSError *lserror)
+{
+    std::lock_guard<std::mutex> locker(state().mutex);
+    if (!state().live.count(sh))
+        return setError(lserror, "Invalid handle");
+
+    sh->cancelFunction = cancelFunction;
+    sh->cancelContext = ctx;
+    return true;
+}
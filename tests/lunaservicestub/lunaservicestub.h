@@ -0,0 +1,110 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#ifndef LUNASERVICESTUB_H
+#define LUNASERVICESTUB_H
+
+#include <functional>
+#include <string>
+
+#include <luna-service2/lunaservice.h>
+
+    /*!
+     * \class LunaServiceStub
+     * \brief In-process stand-in for the luna-service2 library
+     *
+     * Linked instead of luna-service2, it implements the part of the LS2
+     * API the bridge uses: registration, the LSCall variants with
+     * LSCallCancel and LSCallSetTimeout, the messages and the
+     * subscriptions. There is no hub. A call is answered by a method
+     * registered on another handle of the process, by the script set for
+     * its URI or by the responder, in that order. A call nothing answers
+     * gets a ServiceDown hub error.
+     *
+     * As with LS2, the replies and the requests are dispatched from the
+     * GMainContext the handle is attached to, in the order they were
+     * sent. The calls can be made from any thread.
+     */
+
+class LunaServiceStub
+{
+public:
+    /*!
+     * \brief A call as seen by the responder
+     */
+    struct Call
+    {
+        LSHandle *handle;
+        LSMessageToken token;
+        // "luna://service/method"
+        std::string uri;
+        std::string payload;
+        // Set by the LSCall*FromApplication variants
+        std::string appId;
+        bool oneReply;
+    };
+
+    /*!
+     * \brief How the calls to a URI are answered
+     */
+    struct Script
+    {
+        // Sent as every reply
+        std::string payload;
+        // Replies to a subscription, -1 for as many as it takes. A one
+        // reply call gets one.
+        int replies = 1;
+        // Replies per second to a subscription, 0 for one per iteration
+        // of the context
+        double rate = 0;
+        // Before the first reply, in microseconds
+        int delay = 0;
+    };
+
+    /*!
+     * \brief Called on the thread of the call, for the calls without a
+     * script. Answers with reply() or hubError(), then or later.
+     */
+    typedef std::function<void (const Call& call)> Responder;
+
+    static void setScript(const std::string& uri, const Script& script);
+    static void removeScript(const std::string& uri);
+    static void setResponder(const Responder& responder);
+
+    /*!
+     * \brief Sends a reply to a call
+     * \return false if the call is over, e.g. cancelled or answered
+     */
+    static bool reply(LSMessageToken token, const std::string& payload);
+
+    /*!
+     * \brief Ends a call with a hub error, e.g. LUNABUS_ERROR_SERVICE_DOWN
+     */
+    static bool hubError(LSMessageToken token, const std::string& error);
+
+    /*!
+     * \brief Number of calls waiting for a reply or subscribed
+     */
+    static size_t pendingCalls();
+
+    /*!
+     * \brief Drops the scripts and the responder
+     */
+    static void reset();
+};
+
+#endif // LUNASERVICESTUB_H
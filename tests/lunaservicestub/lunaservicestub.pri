@@ -0,0 +1,28 @@
+# Copyright (c) 2026 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+
+# Links the luna-service2 stand-in instead of luna-service2. Include it
+# before plugin.pri, which then leaves luna-service2 out.
+
+CONFIG += lunaservicestub link_pkgconfig
+INCLUDEPATH += $$PWD
+
+LIBS += -L$$shadowed($$PWD) -llunaservicestub
+PRE_TARGETDEPS += $$shadowed($$PWD)/liblunaservicestub.a
+
+PKGCONFIG += glib-2.0 PmLogLib
+QMAKE_CXXFLAGS += $$system($$pkgConfigExecutable() --cflags luna-service2)
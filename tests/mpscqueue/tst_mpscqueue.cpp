@@ -0,0 +1,131 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <thread>
+#include <vector>
+
+#include <QtTest>
+
+#include "mpscqueue.h"
+
+struct Item : MpscNode
+{
+    int producer = 0;
+    int value = 0;
+};
+
+class tst_MpscQueue : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void empty();
+    void fifo();
+    void refillAfterDrain();
+    void manyProducers();
+};
+
+void tst_MpscQueue::empty()
+{
+    MpscQueue queue;
+    QVERIFY(!queue.pop());
+    QVERIFY(!queue.pop());
+}
+
+void tst_MpscQueue::fifo()
+{
+    MpscQueue queue;
+    Item items[5];
+    for (int i = 0; i < 5; ++i) {
+        items[i].value = i;
+        queue.push(&items[i]);
+    }
+
+    for (int i = 0; i < 5; ++i) {
+        Item *item = static_cast<Item *>(queue.pop());
+        QVERIFY(item);
+        QCOMPARE(item->value, i);
+    }
+    QVERIFY(!queue.pop());
+}
+
+void tst_MpscQueue::refillAfterDrain()
+{
+    // The last item is unlinked through the stub, the queue must work
+    // the same afterwards, with the same items pushed again
+    MpscQueue queue;
+    Item items[3];
+    for (int i = 0; i < 3; ++i)
+        items[i].value = i;
+
+    for (int round = 0; round < 10; ++round) {
+        const int count = round % 3 + 1;
+        for (int i = 0; i < count; ++i)
+            queue.push(&items[i]);
+        for (int i = 0; i < count; ++i) {
+            Item *item = static_cast<Item *>(queue.pop());
+            QVERIFY(item);
+            QCOMPARE(item->value, i);
+        }
+        QVERIFY(!queue.pop());
+    }
+}
+
+void tst_MpscQueue::manyProducers()
+{
+    static const int s_producers = 4;
+    static const int s_count = 50000;
+
+    MpscQueue queue;
+    std::vector<Item> items(s_producers * s_count);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < s_producers; ++p) {
+        producers.emplace_back([&queue, &items, p]() {
+            for (int i = 0; i < s_count; ++i) {
+                Item &item = items[p * s_count + i];
+                item.producer = p;
+                item.value = i;
+                queue.push(&item);
+            }
+        });
+    }
+
+    // Each producer's items come out in the order it pushed them
+    std::vector<int> next(s_producers, 0);
+    bool ordered = true;
+    int received = 0;
+    while (received < s_producers * s_count) {
+        Item *item = static_cast<Item *>(queue.pop());
+        if (!item) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && item->value == next[item->producer];
+        next[item->producer] = item->value + 1;
+        ++received;
+    }
+
+    for (std::thread &producer : producers)
+        producer.join();
+
+    QVERIFY(ordered);
+    QVERIFY(!queue.pop());
+}
+
+QTEST_APPLESS_MAIN(tst_MpscQueue)
+
+#include "tst_mpscqueue.moc"
@@ -0,0 +1,144 @@
+// Copyright (c) 2026 LG Electronics, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// SPDX-License-Identifier: Apache-2.0
+
+
+#include <memory>
+#include <thread>
+
+#include <QtTest>
+
+#include "spscring.h"
+
+class tst_SpscRing : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void fifo();
+    void fullRing();
+    void wrapAround();
+    void releasesPoppedValues();
+    void twoThreads();
+};
+
+void tst_SpscRing::fifo()
+{
+    SpscRing<int> ring(8);
+    QVERIFY(ring.isEmpty());
+
+    for (int i = 0; i < 5; ++i)
+        QVERIFY(ring.push(i));
+    QVERIFY(!ring.isEmpty());
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i) {
+        QVERIFY(ring.pop(value));
+        QCOMPARE(value, i);
+    }
+    QVERIFY(!ring.pop(value));
+    QVERIFY(ring.isEmpty());
+}
+
+void tst_SpscRing::fullRing()
+{
+    // Rounded up to 8
+    SpscRing<int> ring(5);
+
+    for (int i = 0; i < 8; ++i)
+        QVERIFY(ring.push(i));
+    QCOMPARE(ring.size(), size_t(8));
+
+    int rejected = 42;
+    QVERIFY(!ring.push(rejected));
+    QCOMPARE(rejected, 42);
+
+    int value = -1;
+    QVERIFY(ring.pop(value));
+    QCOMPARE(value, 0);
+    QCOMPARE(ring.size(), size_t(7));
+    QVERIFY(ring.push(rejected));
+}
+
+void tst_SpscRing::wrapAround()
+{
+    SpscRing<int> ring(4);
+
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 100; ++round) {
+        // Never more than the capacity in the ring
+        for (int i = 0; i < 3; ++i) {
+            int value = ++next;
+            QVERIFY(ring.push(value));
+        }
+        int value = -1;
+        for (int i = 0; i < 3; ++i) {
+            QVERIFY(ring.pop(value));
+            QCOMPARE(value, ++expected);
+        }
+    }
+    QVERIFY(ring.isEmpty());
+}
+
+void tst_SpscRing::releasesPoppedValues()
+{
+    SpscRing<std::shared_ptr<int>> ring(4);
+
+    std::shared_ptr<int> value = std::make_shared<int>(1);
+    std::weak_ptr<int> watch = value;
+    QVERIFY(ring.push(value));
+    QVERIFY(!value);
+
+    std::shared_ptr<int> popped;
+    QVERIFY(ring.pop(popped));
+    QCOMPARE(watch.use_count(), long(1));
+
+    popped.reset();
+    QVERIFY(watch.expired());
+}
+
+void tst_SpscRing::twoThreads()
+{
+    static const int s_count = 200000;
+    SpscRing<int> ring(64);
+
+    std::thread producer([&ring]() {
+        for (int i = 0; i < s_count; ++i) {
+            int value = i;
+            while (!ring.push(value))
+                std::this_thread::yield();
+        }
+    });
+
+    bool ordered = true;
+    int value = -1;
+    for (int expected = 0; expected < s_count; ) {
+        if (!ring.pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        ordered = ordered && value == expected;
+        ++expected;
+    }
+
+    producer.join();
+    QVERIFY(ordered);
+    QVERIFY(ring.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(tst_SpscRing)
+
+#include "tst_spscring.moc"
@@ -0,0 +1,27 @@
+# Copyright (c) 2026 LG Electronics, Inc.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# Common settings of the test cases. A test case that needs the whole
+# bridge includes plugin.pri, the others list the sources they test.
+
+QT += testlib
+CONFIG += testcase c++11 console
+CONFIG -= app_bundle
+
+INCLUDEPATH += $$PWD/../plugin
+
+MOC_DIR = .moc
+OBJECTS_DIR = .obj